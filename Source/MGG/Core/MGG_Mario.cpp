@@ -6,8 +6,10 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
-#include "Kismet/GameplayStatics.h"
 #include "MGG/GravityFields/BaseGravityFieldComponent.h"
+#include "MGG/Movement/GravityMovementComponent.h"
+#include "MGG/Movement/GravityOrientationComponent.h"
+#include "MGG/Utils/Subsystems/GravityWorldSubsystem.h"
 
 /**
  * @brief Constructor for the player character.
@@ -16,11 +18,11 @@
  * 1. Creates a static mesh component for visual representation
  * 2. Sets up a spring arm and camera for third-person view
  * 3. Configures camera settings for smooth following and rotation
- * 4. Sets initial physics values and movement properties
+ * 4. Creates the gravity movement and orientation components moving and aligning the mesh
  */
 AMGG_Mario::AMGG_Mario()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
 	RootComponent = MeshComponent;
@@ -47,6 +49,11 @@ AMGG_Mario::AMGG_Mario()
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	FollowCamera->bUsePawnControlRotation = false;
+
+	GravityMovement = CreateDefaultSubobject<UGravityMovementComponent>(TEXT("GravityMovement"));
+	GravityMovement->UpdatedComponent = RootComponent;
+
+	GravityOrientation = CreateDefaultSubobject<UGravityOrientationComponent>(TEXT("GravityOrientation"));
 }
 
 /**
@@ -54,27 +61,28 @@ AMGG_Mario::AMGG_Mario()
  *
  * @details Initializes the player's starting state:
  * 1. Sets default gravity vector (typically downward)
- * 2. Searches the level for gravity field components
- * 3. Checks if the player starts within any gravity fields
- * 4. Sets initial gravity vector based on starting position
+ * 2. Asks the gravity subsystem which registered fields contain the starting position
+ * 3. Sets initial gravity vector based on starting position
+ * 4. Registers with the gravity subsystem, which then updates the gravity vector before each tick
+ * 5. Applies the initial camera rotation
  */
 void AMGG_Mario::BeginPlay()
 {
 	Super::BeginPlay();
+	UpdateCameraRotation();
 	GravityVector = FVector(0, 0, -980.0f);  // Default gravity
 	
-	TArray<AActor*> AllActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), AllActors);
-
-	for (const AActor* Actor : AllActors)
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
 	{
-		if (UBaseGravityFieldComponent* GravityField = Actor->FindComponentByClass<UBaseGravityFieldComponent>())
+		TArray<UBaseGravityFieldComponent*> StartingGravityFields;
+		GravitySubsystem->GetGravityFieldsAtLocation(GetActorLocation(), StartingGravityFields);
+
+		for (UBaseGravityFieldComponent* GravityField : StartingGravityFields)
 		{
-			if (GravityField->IsActorInGravityField(this))
-			{
-				GravityFields.Add(GravityField);
-			}
+			AddGravityField(GravityField);
 		}
+
+		GravitySubsystem->RegisterGravityAffected(this);
 	}
 	
 	if (GravityFields.Num() > 0)
@@ -88,6 +96,23 @@ void AMGG_Mario::BeginPlay()
 	}
 }
 
+/**
+ * @brief Called when the actor is removed from play.
+ *
+ * @details Unregisters the player from the gravity subsystem's update pass.
+ *
+ * @param EndPlayReason The reason play ended.
+ */
+void AMGG_Mario::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->UnregisterGravityAffected(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 /**
  * @brief Handles player movement input.
  *
@@ -97,7 +122,7 @@ void AMGG_Mario::BeginPlay()
  * 3. Calculates the up vector as opposite to the current gravity direction
  * 4. Projects forward and right vectors onto the plane perpendicular to gravity
  * 5. Constructs a movement direction vector based on input and projected directions
- * 6. Adds this vector to the character's velocity
+ * 6. Adds this vector as movement input, consumed by the gravity movement component
  *
  * This gravity-relative movement system is key to Super Mario Galaxy-style gameplay,
  * allowing the player to move naturally on any surface regardless of its orientation.
@@ -123,7 +148,7 @@ void AMGG_Mario::Move(const FInputActionValue& Value)
 		// X positive = right, X negative = left
 		FVector DesiredMovement = Forward * MovementVector.Y + Right * MovementVector.X;
 		DesiredMovement.Normalize();
-		Velocity += DesiredMovement;
+		AddMovementInput(DesiredMovement);
 	}
 }
 
@@ -134,6 +159,7 @@ void AMGG_Mario::Move(const FInputActionValue& Value)
  * 1. Updates the camera yaw (horizontal rotation) based on X input
  * 2. Updates the camera pitch (vertical rotation) based on Y input
  * 3. Clamps the pitch value to prevent over-rotation
+ * 4. Applies the new rotation to the camera boom
  *
  * @param Value The input value from the look controls.
  */
@@ -143,6 +169,7 @@ void AMGG_Mario::Look(const FInputActionValue& Value)
 	
 	CameraYaw += LookAxisVector.X;
 	CameraPitch = FMath::Clamp(CameraPitch + LookAxisVector.Y, -80.0f, 80.0f);
+	UpdateCameraRotation();
 }
 
 void AMGG_Mario::Jump()
@@ -156,158 +183,25 @@ void AMGG_Mario::StopJumping()
 }
 
 /**
- * @brief Rotates the character to align with the current gravity direction.
+ * @brief Applies the camera yaw and pitch to the camera boom.
  *
- * @details Calculates and applies the rotation needed to make the character stand
- * perpendicular to the current gravity direction:
- * 1. Normalizes the current gravity vector
- * 2. Establishes reference vectors to calculate orientation
- * 3. Uses cross products to find perpendicular vectors defining the character's plane
- * 4. Calculates rotation to align the character's up vector opposite to gravity
- * 5. Sets the character's rotation to this new orientation
- * 6. Applies camera rotation relative to the new character orientation
- *
- * This method is essential for creating the illusion that the character is properly
- * standing on surfaces of any orientation, which is a signature feature of
- * Super Mario Galaxy's gameplay.
+ * @details The boom inherits no rotation from the character, so its rotation only changes
+ * with the look input, not with the character's orientation.
  */
-void AMGG_Mario::RotatingMario()
+void AMGG_Mario::UpdateCameraRotation()
 {
-	FVector NG = GravityVector;
-	NG.Normalize();
-
-	//Check the reference of the Vector
-	FVector temp = FVector(1, 0, 0);
-	if (FVector::DotProduct(NG, temp) > 0.99) { temp = FVector(0, 1, 0); }
-
-	FVector VR = FVector::CrossProduct(NG, temp);
-	VR.Normalize();
-	VR = FVector::CrossProduct(NG, VR);
-	VR.Normalize();
-
-	FVector PointDepart = GetActorLocation();
-	FVector PlaneNormal = -NG.GetSafeNormal();
-
-	//Debug Forward Vector in Yellow
-	{
-		DrawDebugLine(
-			GetWorld(),
-			PointDepart,
-			PointDepart + GetActorForwardVector() * 100.f,
-			FColor::Yellow,
-			false,
-			.1f,
-			0,
-			1.0f
-		);
-	}
-	//Debug Up Vector in Black
-	{
-		DrawDebugLine(
-			GetWorld(),
-			PointDepart,
-			PointDepart + GetActorUpVector() * 100.f,
-			FColor::Black,
-			false,
-			.1f,
-			0,
-			1.0f
-		);
-	}
-	
-	FVector DefaultUp = FVector(0, 0, 1);
-	FQuat AlignementRotation = FQuat::FindBetweenVectors(DefaultUp, PlaneNormal);
-
-	FRotator NewRotation = AlignementRotation.Rotator();
-	SetActorRotation(NewRotation);
 	FQuat RCamera = FQuat::MakeFromRotator(FRotator(CameraPitch, CameraYaw, 0));
 	CameraBoom->SetRelativeRotation(RCamera);
 }
 
 /**
- * @brief Called every frame to update the character.
- *
- * @details Calls PhysicProcess to handle physics simulation and then performs
- * standard actor tick operations.
- *
- * @param DeltaTime The time elapsed since the last frame.
- */
-void AMGG_Mario::Tick(float DeltaTime)
-{
-	PhysicProcess(DeltaTime);
-	Super::Tick(DeltaTime);
-}
-
-/**
- * @brief Processes physics simulation for the character on each frame.
+ * @brief Gets the movement component moving the character.
  *
- * @details Handles all physics-related updates for the player character:
- * 1. Updates the current gravity field affecting the player
- * 2. Performs ground detection using a raycast in the gravity direction
- * 3. Applies gravity only when the character is not grounded
- * 4. Updates the character's position based on velocity and gravity
- * 5. Resets velocity after movement is applied
- * 6. Calls RotatingMario() to align the character with the current gravity
- *
- * This method is crucial for the Mario Galaxy-style gameplay as it handles
- * how the character interacts with gravity fields and surfaces.
- *
- * @param DeltaTime The time elapsed since the last frame.
+ * @return The gravity movement component.
  */
-void AMGG_Mario::PhysicProcess(float DeltaTime)
+UPawnMovementComponent* AMGG_Mario::GetMovementComponent() const
 {
-	UpdateCurrentGravityField();
-	
-	float UsingGravity = 1;
-
-	FVector PointDepart = GetActorLocation();
-
-	// End point (forward direction * distance)
-	FVector Direction = GravityVector;
-	Direction.Normalize();
-	FVector PointArrivee = PointDepart + (Direction * 120.0f);
-
-	// Raycast configuration
-	FHitResult ResultatHit;
-	FCollisionQueryParams ParamsCollision;
-	ParamsCollision.AddIgnoredActor(this); // Ignore self
-	TEnumAsByte<ECollisionChannel> CanalCollision = ECC_Visibility;
-	
-	// Perform raycast
-	bool aHit = GetWorld()->LineTraceSingleByChannel(
-		ResultatHit,
-		PointDepart,
-		PointArrivee,
-		CanalCollision,
-		ParamsCollision
-	);
-
-	// Draw a debug line to visualize the raycast
-	DrawDebugLine(
-		GetWorld(),
-		PointDepart,
-		PointArrivee,
-		FColor::Red,
-		false,
-		2.0f,
-		0,
-		1.0f
-	);
-
-	// If the raycast has touched anything
-	if (aHit)
-	{
-		UsingGravity = 0;
-	}
-	else
-	{
-		UsingGravity = 1;
-	}
-
-	FVector NewLocation = GetActorLocation() + (Velocity * DeltaTime * Speed) + (GravityVector * DeltaTime * UsingGravity);
-	Velocity = FVector(0);
-	SetActorLocation(NewLocation, true);
-	RotatingMario();
+	return GravityMovement;
 }
 
 /**
@@ -401,8 +295,8 @@ void AMGG_Mario::OnExitGravityField_Implementation()
  * 2. If a field is found, updates the gravity vector based on the character's position
  * 3. If no field is found, could optionally reset to default gravity
  *
- * This method is typically called each frame to ensure the character always
- * experiences the correct gravitational influence as they move through the world.
+ * The gravity subsystem's update pass already does this every frame for registered actors,
+ * and is the only place blending overlapping fields (bBlendGravityFields) is handled.
  */
 void AMGG_Mario::UpdateCurrentGravityField()
 {
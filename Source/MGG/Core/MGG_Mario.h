@@ -12,6 +12,9 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
+class UGravityMovementComponent;
+class UGravityOrientationComponent;
+class UPawnMovementComponent;
 
 //// Struct
 struct FInputActionValue;
@@ -26,8 +29,8 @@ public:
 	AMGG_Mario();
 
 	//////// UNREAL LIFECYCLE ////////
-	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
+	virtual UPawnMovementComponent* GetMovementComponent() const override;
 
 	//////// INTERFACE IMPLEMENTATIONS ////////
 	//// IGravityAffected implementation
@@ -41,6 +44,7 @@ public:
 	//////// INLINE METHODS ////////
 	//// IGravityAffected implementation
 	FORCEINLINE virtual FVector& GetGravityVector() override { return GravityVector; }
+	FORCEINLINE virtual bool ShouldBlendGravityFields() const override { return bBlendGravityFields; }
 	
 	//////// FIELDS ////////
 	//// Input fields
@@ -55,11 +59,9 @@ public:
 
 	//// Movement fields
 	UPROPERTY(BlueprintReadOnly)
-	FVector Velocity;
-	UPROPERTY(BlueprintReadOnly)
 	FVector GravityVector;
 	UPROPERTY(EditAnywhere, Category = Movement)
-	float Speed = 500.0f;
+	bool bBlendGravityFields = false;
 
 	//// Components fields
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
@@ -68,6 +70,10 @@ public:
 	UCameraComponent* FollowCamera;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* MeshComponent;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
+	UGravityMovementComponent* GravityMovement;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
+	UGravityOrientationComponent* GravityOrientation;
 
 	//// Camera fields
 	UPROPERTY()
@@ -78,6 +84,7 @@ public:
 protected:
 	//////// UNREAL LIFECYCLE ////////
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	//////// METHODS ////////
 	//// Input methods
@@ -86,9 +93,8 @@ protected:
 	void Jump();
 	void StopJumping();
 
-	//// Physics methods
-	void PhysicProcess(float DeltaTime);
-	void RotatingMario();
+	//// Camera methods
+	void UpdateCameraRotation();
 
 private:
 	//////// FIELDS ////////
@@ -3,6 +3,9 @@
 #include "Components/LineBatchComponent.h"
 #include "Components/ShapeComponent.h"
 #include "MGG/Utils/Drawers/GravityFieldDrawer.h"
+#include "MGG/Utils/Subsystems/GravityWorldSubsystem.h"
+#include "MGG/GravityFields/GravityFieldMath.h"
+#include "MGG/GravityFields/GravityFieldCache.h"
 
 /**
  * @brief Constructor for the base gravity field component.
@@ -12,7 +15,7 @@
  */
 UBaseGravityFieldComponent::UBaseGravityFieldComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 
 	GravityStrength = 9.81f;
 	GravityFieldPriority = 0;
@@ -23,8 +26,8 @@ UBaseGravityFieldComponent::UBaseGravityFieldComponent()
 /**
  * @brief Called when the component is registered with the scene.
  *
- * @details Initializes the field dimensions and sets up the debug drawing system
- * if debug visualization is enabled.
+ * @details Initializes the field dimensions, registers the field with the world's
+ * gravity subsystem and sets up the debug drawing system if debug visualization is enabled.
  */
 void UBaseGravityFieldComponent::OnRegister()
 {
@@ -32,6 +35,11 @@ void UBaseGravityFieldComponent::OnRegister()
 
 	UpdateFieldDimensions();
 
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->RegisterGravityField(this);
+	}
+
 	if (!currentDrawer)
 	{
 		currentDrawer = MakeUnique<GravityFieldDrawer>(DebugLines);
@@ -39,20 +47,271 @@ void UBaseGravityFieldComponent::OnRegister()
 		{
 			DebugLines->Flush();
 			DrawDebugGravityField();
+			DebugDrawTransform = GetComponentTransform();
 		}
 	}
 }
 
+/**
+ * @brief Called when the component is unregistered from the scene.
+ *
+ * @details Removes the field from the world's gravity subsystem so it is no longer
+ * returned by location queries.
+ */
+void UBaseGravityFieldComponent::OnUnregister()
+{
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->UnregisterGravityField(this);
+	}
+
+	Super::OnUnregister();
+}
+
 /**
  * @brief Updates the dimensions of the gravity field.
  *
  * @details Calculates the current dimensions of the gravity field based on the owner's
- * properties and updates the collision volume accordingly.
+ * properties, updates the collision volume and the field snapshot accordingly and refits
+ * the field in the gravity subsystem's spatial index.
  */
 void UBaseGravityFieldComponent::UpdateFieldDimensions()
 {
 	CurrentDimensions = CalculateFieldDimensions();
+	DimensionsScale = GetComponentScale();
 	UpdateGravityVolume();
+	RebuildFieldSnapshot();
+
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->UpdateGravityField(this);
+	}
+}
+
+/**
+ * @brief Queues a change of the field to be applied at the next dirty list flush.
+ *
+ * @details The first change of a frame adds the field to the gravity subsystem's dirty list,
+ * later ones only add their flags. A field that is not registered with a subsystem (e.g. in an
+ * editor preview world) has no one to flush it, so it applies the change right away.
+ *
+ * @param DirtyFlags What the change invalidated.
+ */
+void UBaseGravityFieldComponent::MarkGravityFieldDirty(EGravityFieldDirtyFlags DirtyFlags)
+{
+	if (DirtyFlags == EGravityFieldDirtyFlags::None)
+	{
+		return;
+	}
+
+	const bool bAlreadyQueued = PendingDirtyFlags != EGravityFieldDirtyFlags::None;
+	PendingDirtyFlags |= DirtyFlags;
+
+	UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this);
+	if (!GravitySubsystem || !GravitySubsystem->IsValidHandle(RegistryHandle))
+	{
+		FlushDirtyState();
+	}
+	else if (!bAlreadyQueued)
+	{
+		GravitySubsystem->EnqueueDirtyGravityField(this);
+	}
+}
+
+/**
+ * @brief Applies every queued change, rebuilding only what the changes invalidated.
+ *
+ * @details Each step implies the ones it feeds: new dimensions change the snapshot, the
+ * registered bounds and the debug drawing, and a new snapshot has to be published in the scene.
+ *
+ * A rigid motion of a kinematic field skips the dimensions entirely: no mesh bounds lookup and no
+ * volume resize (the volume is attached, so it already followed), only the transform part of the
+ * snapshot is refreshed and the existing debug lines are moved along. Kinematic fields never bake
+ * a cache (see ShouldBakeGravityCache); one still holding a cache baked before it became kinematic
+ * rebuilds its snapshot once, which drops it.
+ *
+ * @return Every flag that was applied, including the implied ones.
+ */
+EGravityFieldDirtyFlags UBaseGravityFieldComponent::FlushDirtyState()
+{
+	EGravityFieldDirtyFlags DirtyFlags = PendingDirtyFlags;
+	PendingDirtyFlags = EGravityFieldDirtyFlags::None;
+
+	if (EnumHasAnyFlags(DirtyFlags, EGravityFieldDirtyFlags::Dimensions))
+	{
+		CurrentDimensions = CalculateFieldDimensions();
+		DimensionsScale = GetComponentScale();
+		UpdateGravityVolume();
+		DirtyFlags |= EGravityFieldDirtyFlags::Snapshot | EGravityFieldDirtyFlags::Registry | EGravityFieldDirtyFlags::Debug;
+	}
+	else if (EnumHasAnyFlags(DirtyFlags, EGravityFieldDirtyFlags::Transform))
+	{
+		CurrentDimensions.Center = GetComponentLocation();
+		DirtyFlags |= EGravityFieldDirtyFlags::Registry;
+
+		if (FieldSnapshot.Cache)
+		{
+			DirtyFlags |= EGravityFieldDirtyFlags::Snapshot;
+		}
+		else if (!EnumHasAnyFlags(DirtyFlags, EGravityFieldDirtyFlags::Snapshot))
+		{
+			UpdateSnapshotTransform();
+			DirtyFlags |= EGravityFieldDirtyFlags::Scene;
+		}
+	}
+
+	if (EnumHasAnyFlags(DirtyFlags, EGravityFieldDirtyFlags::Snapshot))
+	{
+		RebuildFieldSnapshot();
+		DirtyFlags |= EGravityFieldDirtyFlags::Scene;
+	}
+
+	if (EnumHasAnyFlags(DirtyFlags, EGravityFieldDirtyFlags::Registry))
+	{
+		if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+		{
+			GravitySubsystem->UpdateGravityField(this);
+		}
+	}
+
+	if (EnumHasAnyFlags(DirtyFlags, EGravityFieldDirtyFlags::Debug))
+	{
+		RedrawDebugField();
+	}
+	else if (EnumHasAnyFlags(DirtyFlags, EGravityFieldDirtyFlags::Transform) && bShowDebugField && currentDrawer)
+	{
+		const FTransform NewDrawTransform = GetComponentTransform();
+		currentDrawer->TransformLines(DebugDrawTransform, NewDrawTransform);
+		DebugDrawTransform = NewDrawTransform;
+	}
+
+	return DirtyFlags;
+}
+
+/**
+ * @brief Refreshes only the transform-dependent part of the field snapshot.
+ *
+ * @details Used by kinematic fields after a rigid motion: shape dimensions (radii, heights)
+ * and the volume shape are unchanged, only where the field sits and how it is oriented moved.
+ * Shapes with world-space parameters refresh them in FillFieldSnapshotTransform.
+ */
+void UBaseGravityFieldComponent::UpdateSnapshotTransform()
+{
+	FieldSnapshot.Center = CurrentDimensions.Center;
+	FieldSnapshot.Rotation = GetComponentQuat();
+	FieldSnapshot.UpVector = GetUpVector();
+	FieldSnapshot.Bounds = GetFieldBounds();
+
+	if (GravityVolume)
+	{
+		FieldSnapshot.VolumeTransform = GravityVolume->GetComponentTransform();
+		FieldSnapshot.VolumeTransform.SetScale3D(FVector::OneVector);
+	}
+
+	FillFieldSnapshotTransform(FieldSnapshot);
+	BumpFieldVersion();
+}
+
+/**
+ * @brief Lets the shape refresh its own transform-dependent snapshot parameters.
+ *
+ * @details Called by UpdateSnapshotTransform after the common transform data. Shapes whose
+ * parameters are expressed in world space, rather than in the field's local frame, override
+ * it so a rigid motion does not leave them stale. Does nothing by default.
+ *
+ * @param Snapshot The snapshot being refreshed.
+ */
+void UBaseGravityFieldComponent::FillFieldSnapshotTransform(FGravityFieldSnapshot& Snapshot) const
+{
+}
+
+/**
+ * @brief Rebuilds the immutable parameter snapshot used by gravity queries.
+ *
+ * @details Copies the gravity settings and the gravity volume (shape, transform, bounds),
+ * then lets the shape fill in its own parameters (center, axes, extents, radii). This is the
+ * only place where shape fields are allowed to look up owner components, so
+ * CalculateGravityVector can read the snapshot alone.
+ *
+ * When the field bakes a cache, the gravity cache is baked again from the new snapshot,
+ * so a cache can never outlive the transform or settings it was baked with. The field version
+ * is bumped for the same reason, invalidating the gravity samples actors took from the old snapshot.
+ *
+ * Called whenever the field dimensions are recalculated (registration, transform change,
+ * planet settings change) and after editor property changes.
+ */
+void UBaseGravityFieldComponent::RebuildFieldSnapshot()
+{
+	FGravityFieldSnapshot Snapshot;
+	Snapshot.Center = GetComponentLocation();
+	Snapshot.Rotation = GetComponentQuat();
+	Snapshot.UpVector = GetUpVector();
+	Snapshot.GravityStrength = GravityStrength;
+	Snapshot.GravityFieldPriority = GravityFieldPriority;
+	Snapshot.BlendDistance = GravityBlendDistance;
+	Snapshot.Bounds = GetFieldBounds();
+
+	if (GravityVolume)
+	{
+		Snapshot.VolumeTransform = GravityVolume->GetComponentTransform();
+		Snapshot.VolumeTransform.SetScale3D(FVector::OneVector);
+		Snapshot.VolumeShape = GravityVolume->GetCollisionShape();
+	}
+
+	FillFieldSnapshot(Snapshot);
+	Snapshot.Cache = BuildGravityCache(Snapshot);
+
+	FieldSnapshot = Snapshot;
+	BumpFieldVersion();
+}
+
+/**
+ * @brief Bakes the gravity cache selected by GravityCacheMode.
+ *
+ * @details Baking evaluates the shape kernel over the whole field, which is meant for fields
+ * that rarely change: moving fields keep the analytic evaluation (see ShouldBakeGravityCache).
+ *
+ * @param Snapshot The freshly filled snapshot to bake.
+ * @return The baked cache, or null when the field does not bake one.
+ */
+TSharedPtr<const FGravityFieldCache, ESPMode::ThreadSafe> UBaseGravityFieldComponent::BuildGravityCache(const FGravityFieldSnapshot& Snapshot) const
+{
+	if (!ShouldBakeGravityCache() || !Snapshot.Bounds.IsValid)
+	{
+		return nullptr;
+	}
+
+	switch (GravityCacheMode)
+	{
+	case EGravityFieldCacheMode::UniformGrid:
+		return MakeShared<FGravityFieldGridCache, ESPMode::ThreadSafe>(Snapshot, GravityCacheCellSize);
+	case EGravityFieldCacheMode::SparseOctree:
+		{
+			FGravityFieldOctreeSettings Settings;
+			Settings.AngularTolerance = GravityCacheAngularTolerance;
+			Settings.MagnitudeTolerance = GravityCacheMagnitudeTolerance;
+			Settings.MinDepth = FMath::Min(GravityCacheMinDepth, GravityCacheMaxDepth);
+			Settings.MaxDepth = GravityCacheMaxDepth;
+			Settings.MaxNodes = GravityCacheMaxNodes;
+			return MakeShared<FGravityFieldOctreeCache, ESPMode::ThreadSafe>(Snapshot, Settings);
+		}
+	default:
+		return nullptr;
+	}
+}
+
+/**
+ * @brief Tells whether the field bakes the cache selected by GravityCacheMode.
+ *
+ * @details The cache is baked in world space, so every motion of the field would bake it again
+ * on the game thread. Kinematic fields, and fields that moved after BeginPlay, use the analytic
+ * kernel instead: the cache is only kept for fields that stay where they were placed.
+ *
+ * @return True if the field has a cache mode and does not move.
+ */
+bool UBaseGravityFieldComponent::ShouldBakeGravityCache() const
+{
+	return GravityCacheMode != EGravityFieldCacheMode::None && !bKinematicMotion && !bMovedDuringPlay;
 }
 
 /**
@@ -74,8 +333,12 @@ void UBaseGravityFieldComponent::OnGravityVolumeBeginOverlap(UPrimitiveComponent
 	{
 		if (IGravityAffected* AffectedActor = Cast<IGravityAffected>(OtherActor))
 		{
-			AffectedActor->GravityFields.Add(this);
+			AffectedActor->AddGravityField(this);
 			UBaseGravityFieldComponent* NewActiveField = AffectedActor->GetActiveGravityField();
+			if (!NewActiveField)
+			{
+				return;
+			}
 
 			FVector GravityVector = NewActiveField->CalculateGravityVector(OtherActor->GetActorLocation());
 			IGravityAffected::Execute_OnEnterGravityField(OtherActor, GravityVector);
@@ -88,7 +351,8 @@ void UBaseGravityFieldComponent::OnGravityVolumeBeginOverlap(UPrimitiveComponent
  *
  * @details When an actor implementing the IGravityAffected interface exits the gravity field,
  * this method removes the field from the actor's list of active fields and updates the actor's
- * gravity if necessary.
+ * gravity if necessary (see IGravityAffected::LeaveGravityField). A field that was unregistered
+ * first has already notified the actors inside it, and has no handle left to remove.
  *
  * @param OverlappedComponent The component that was overlapped.
  * @param OtherActor The actor that exited the field.
@@ -101,27 +365,66 @@ void UBaseGravityFieldComponent::OnGravityVolumeEndOverlap(UPrimitiveComponent*
 	{
 		if (IGravityAffected* AffectedActor = Cast<IGravityAffected>(OtherActor))
 		{
-			bool wasActiveField = false;
-		
-			if (AffectedActor->GetActiveGravityField() == this)
-			{
-				wasActiveField = true;
-			}
-			
-			AffectedActor->GravityFields.Remove(this);
-    
-			if (wasActiveField)
+			AffectedActor->LeaveGravityField(GetGravityFieldHandle());
+		}
+	}
+}
+
+/**
+ * @brief Calculates the gravity vectors for a batch of target locations.
+ *
+ * @details Batched counterpart of CalculateGravityVector. Positions are passed as three
+ * contiguous streams (structure-of-arrays) and the results are written into a caller-owned
+ * output array, so a whole population of gravity-affected objects can be evaluated against
+ * this field in a single pass.
+ *
+ * This default implementation simply forwards each point to CalculateGravityVector.
+ * Shape fields override it to hoist the per-field work (location, axes, mesh lookups)
+ * out of the loop so that only the shape math remains per point.
+ *
+ * @param PositionsX The X coordinates of the target locations.
+ * @param PositionsY The Y coordinates of the target locations.
+ * @param PositionsZ The Z coordinates of the target locations.
+ * @param OutGravityVectors Receives one gravity vector per target location.
+ */
+void UBaseGravityFieldComponent::CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const
+{
+	check(PositionsX.Num() == PositionsY.Num() && PositionsX.Num() == PositionsZ.Num());
+	check(OutGravityVectors.Num() >= PositionsX.Num());
+
+	for (int32 Index = 0; Index < PositionsX.Num(); ++Index)
+	{
+		OutGravityVectors[Index] = CalculateGravityVector(FVector(PositionsX[Index], PositionsY[Index], PositionsZ[Index]));
+	}
+}
+
+/**
+ * @brief Sets the priority of the gravity field.
+ *
+ * @details Besides updating the field and its snapshot, queues the priority update of the
+ * gravity subsystem's registry and re-sorts the field in the priority index of every
+ * gravity-affected actor currently inside its volume, so their active field stays correct.
+ *
+ * @param NewGravityFieldPriority The new priority of the field.
+ */
+void UBaseGravityFieldComponent::SetGravityFieldPriority(int32 NewGravityFieldPriority)
+{
+	GravityFieldPriority = NewGravityFieldPriority;
+	FieldSnapshot.GravityFieldPriority = NewGravityFieldPriority;
+	BumpFieldVersion();
+
+	MarkGravityFieldDirty(EGravityFieldDirtyFlags::Registry | EGravityFieldDirtyFlags::Scene);
+
+	if (GravityVolume)
+	{
+		TArray<AActor*> OverlappingActors;
+		GravityVolume->GetOverlappingActors(OverlappingActors, UGravityAffected::StaticClass());
+
+		for (AActor* OverlappingActor : OverlappingActors)
+		{
+			if (IGravityAffected* AffectedActor = Cast<IGravityAffected>(OverlappingActor))
 			{
-				if (AffectedActor->GravityFields.Num() > 0)
-				{
-					UBaseGravityFieldComponent* NewActiveField = AffectedActor->GetActiveGravityField();
-					FVector GravityVector = NewActiveField->CalculateGravityVector(OtherActor->GetActorLocation());
-					IGravityAffected::Execute_OnEnterGravityField(OtherActor, GravityVector);
-				}
-				else
-				{
-					IGravityAffected::Execute_OnExitGravityField(OtherActor);
-				}
+				AffectedActor->RefreshGravityFieldPriority(this);
 			}
 		}
 	}
@@ -150,6 +453,53 @@ float UBaseGravityFieldComponent::GetTotalGravityRadius() const
 	return GravityInfluenceRange;
 }
 
+/**
+ * @brief Gets the world-space bounding box of the gravity field.
+ *
+ * @details Used by the gravity subsystem's spatial index. The default implementation
+ * returns a cube around the field center that encloses both the current field dimensions
+ * and the total gravity radius, which is exact for spherical volumes. Fields whose volume
+ * is elongated or offset from the center override it with a tighter box.
+ *
+ * @return The world bounds of the gravity field volume.
+ */
+FBox UBaseGravityFieldComponent::GetFieldBounds() const
+{
+	const float BoundingRadius = FMath::Max(CurrentDimensions.Size.GetMax(), GetTotalGravityRadius());
+	return FBox::BuildAABB(CurrentDimensions.Center, FVector(BoundingRadius));
+}
+
+/**
+ * @brief Checks whether a world location lies inside the gravity volume.
+ *
+ * @details Tests the location against the gravity volume shape (sphere, box or capsule)
+ * mirrored in the field snapshot. Unlike IsActorInGravityField,
+ * this does not rely on overlap events and can be used for any point, e.g. to find the
+ * fields containing a pawn at spawn time.
+ *
+ * @param Location The world location to test.
+ * @return True if the location is inside the gravity volume.
+ */
+bool UBaseGravityFieldComponent::IsLocationInGravityField(const FVector& Location) const
+{
+	return GravityVolume && FGravityFieldMath::IsLocationInVolume(FieldSnapshot, Location);
+}
+
+/**
+ * @brief Calculates where a world location lies relative to the planet surface of this field.
+ *
+ * @details Evaluated analytically from the field snapshot, see FGravityFieldMath::CalculateSurfaceContact.
+ *
+ * @param Location The world location to test.
+ * @param OutSignedDistance Receives the distance to the surface: positive outside the planet, negative inside it.
+ * @param OutSurfaceNormal Receives the outward surface normal at the closest surface point.
+ * @return True if this field's shape describes a surface.
+ */
+bool UBaseGravityFieldComponent::CalculateSurfaceContact(const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal) const
+{
+	return FGravityFieldMath::CalculateSurfaceContact(FieldSnapshot, Location, OutSignedDistance, OutSurfaceNormal);
+}
+
 /**
  * @brief Redraws the debug visualization of the gravity field.
  *
@@ -162,14 +512,18 @@ void UBaseGravityFieldComponent::RedrawDebugField()
 	{
 		DebugLines->Flush();  
 		DrawDebugGravityField();
+		DebugDrawTransform = GetComponentTransform();
 	}
 }
 
 /**
  * @brief Called when the component's transform is updated.
  *
- * @details Updates the field dimensions and debug visualization to reflect
- * the component's new position and orientation.
+ * @details Queues the update of the field dimensions and debug visualization to reflect
+ * the component's new position and orientation. Kinematic fields that were only moved or rotated
+ * queue the cheaper transform update instead; any scale change still recomputes the dimensions.
+ * Rebuilding the snapshot bumps the field version. A field moved after BeginPlay stops baking
+ * its gravity cache.
  * 
  * @param UpdateTransformFlags Flags indicating what aspects of the transform changed.
  * @param Teleport The type of teleportation that occurred, if any.
@@ -177,15 +531,19 @@ void UBaseGravityFieldComponent::RedrawDebugField()
 void UBaseGravityFieldComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
 	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
-	UpdateFieldDimensions();
-	RedrawDebugField();
+
+	bMovedDuringPlay |= HasBegunPlay();
+	const bool bRigidMotion = bKinematicMotion && GetComponentScale().Equals(DimensionsScale);
+	MarkGravityFieldDirty(bRigidMotion ? EGravityFieldDirtyFlags::Transform : EGravityFieldDirtyFlags::Dimensions);
 }
 
 /**
  * @brief Called when a property of the component is changed in the editor.
  *
- * @details Updates the field dimensions and debug visualization if relevant properties
- * such as the gravity influence range are modified.
+ * @details Queues the update of the field dimensions if relevant properties such as the
+ * gravity influence range are modified, and only a debug redraw for the debug toggle. Any other
+ * property change rebuilds the field snapshot, since shape settings (e.g. the cylinder height)
+ * feed into it. Rebuilding the snapshot bumps the field version.
  *
  * @param PropertyChangedEvent Information about the property that was changed.
  */
@@ -197,19 +555,31 @@ void UBaseGravityFieldComponent::PostEditChangeProperty(FPropertyChangedEvent& P
                          
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UBaseGravityFieldComponent, GravityInfluenceRange))
 	{
-		UpdateFieldDimensions();
-		RedrawDebugField();
+		MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UBaseGravityFieldComponent, bShowDebugField))
+	{
+		MarkGravityFieldDirty(EGravityFieldDirtyFlags::Debug);
+	}
+	else
+	{
+		MarkGravityFieldDirty(EGravityFieldDirtyFlags::Snapshot | EGravityFieldDirtyFlags::Debug);
 	}
 }
 
 /**
  * @brief Called before the component is destroyed.
  *
- * @details Cleans up resources and unregisters event handlers to prevent memory leaks
- * and unexpected behavior during destruction.
+ * @details Cleans up resources, unregisters event handlers and removes the field from the
+ * gravity subsystem to prevent memory leaks and unexpected behavior during destruction.
  */
 void UBaseGravityFieldComponent::BeginDestroy()
 {
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->UnregisterGravityField(this);
+	}
+
 	if (GravityVolume)
 	{
 		GravityVolume->OnComponentBeginOverlap.RemoveDynamic(this, &UBaseGravityFieldComponent::OnGravityVolumeBeginOverlap);
@@ -4,13 +4,48 @@
 #include "Components/SceneComponent.h"
 #include "Components/ShapeComponent.h"
 #include "MGG/Utils/Drawers/GravityFieldDrawer.h"
+#include "MGG/GravityFields/GravityFieldSnapshot.h"
+#include "MGG/GravityFields/GravityFieldHandle.h"
 #include "BaseGravityFieldComponent.generated.h"
 
 //////// FORWARD DECLARATION ////////
 //// Class
 class ULineBatchComponent;
 class UShapeComponent;
+class FGravityFieldCache;
 
+/**
+ * @brief How a gravity field precomputes its gravity directions.
+ */
+UENUM()
+enum class EGravityFieldCacheMode : uint8
+{
+	None,			// Gravity is evaluated analytically on every query
+	UniformGrid,	// Gravity is baked on a regular grid and sampled with trilinear interpolation
+	SparseOctree	// Gravity is baked in an octree refined only where interpolation is not accurate enough
+};
+
+/**
+ * @brief What has to be rebuilt for a gravity field that changed.
+ *
+ * @details Fields queue their changes in the gravity subsystem's dirty list instead of rebuilding
+ * on the spot; the list is flushed at the start of the frame and before the gravity update pass,
+ * so a field changed several times in between is only rebuilt once, and only the parts its
+ * changes actually touched.
+ */
+enum class EGravityFieldDirtyFlags : uint8
+{
+	None		= 0,
+	Dimensions	= 1 << 0,	// Size or placement changed: the volume is resized, then everything below is rebuilt
+	Transform	= 1 << 1,	// Rigid motion only (kinematic fields): the snapshot transform, registry and debug lines follow
+	Snapshot	= 1 << 2,	// Shape or cache settings changed: the snapshot and its baked cache are rebuilt
+	Registry	= 1 << 3,	// Bounds or priority changed: the field is refitted in the subsystem's registry and spatial index
+	Scene		= 1 << 4,	// Snapshot data changed: the thread-safe gravity scene is published again
+	Debug		= 1 << 5,	// The debug drawing is out of date
+
+	All			= Dimensions | Transform | Snapshot | Registry | Scene | Debug
+};
+ENUM_CLASS_FLAGS(EGravityFieldDirtyFlags);
 
 UCLASS(Abstract, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class MGG_API UBaseGravityFieldComponent : public USceneComponent
@@ -31,6 +66,30 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Debug")
 	bool bShowDebugField = true;
 
+	//// Motion Fields
+	UPROPERTY(EditAnywhere, Category = "Gravity Motion")
+	bool bKinematicMotion = false; // Moving without scaling only refreshes the transform, for fields animated every frame
+
+	//// Blend Fields
+	UPROPERTY(EditAnywhere, Category = "Gravity Blending", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float GravityBlendDistance = 200.0f;
+
+	//// Cache Fields
+	UPROPERTY(EditAnywhere, Category = "Gravity Cache")
+	EGravityFieldCacheMode GravityCacheMode = EGravityFieldCacheMode::None;
+	UPROPERTY(EditAnywhere, Category = "Gravity Cache", meta = (ClampMin = "1.0", EditCondition = "GravityCacheMode == EGravityFieldCacheMode::UniformGrid"))
+	float GravityCacheCellSize = 50.0f;
+	UPROPERTY(EditAnywhere, Category = "Gravity Cache", meta = (ClampMin = "0.1", Units = "Degrees", EditCondition = "GravityCacheMode == EGravityFieldCacheMode::SparseOctree"))
+	float GravityCacheAngularTolerance = 2.0f;
+	UPROPERTY(EditAnywhere, Category = "Gravity Cache", meta = (ClampMin = "0.001", ClampMax = "1.0", EditCondition = "GravityCacheMode == EGravityFieldCacheMode::SparseOctree"))
+	float GravityCacheMagnitudeTolerance = 0.05f;
+	UPROPERTY(EditAnywhere, Category = "Gravity Cache", meta = (ClampMin = "0", ClampMax = "10", EditCondition = "GravityCacheMode == EGravityFieldCacheMode::SparseOctree"))
+	int32 GravityCacheMinDepth = 2; // Depth refined everywhere, whatever the error
+	UPROPERTY(EditAnywhere, Category = "Gravity Cache", meta = (ClampMin = "1", ClampMax = "10", EditCondition = "GravityCacheMode == EGravityFieldCacheMode::SparseOctree"))
+	int32 GravityCacheMaxDepth = 8;
+	UPROPERTY(EditAnywhere, Category = "Gravity Cache", meta = (ClampMin = "9", EditCondition = "GravityCacheMode == EGravityFieldCacheMode::SparseOctree"))
+	int32 GravityCacheMaxNodes = 1 << 18; // Refinement stops once the budget is spent
+
 	//////// METHODS ////////
 	//// Debug methods
 	virtual void DrawDebugGravityField() PURE_VIRTUAL(UBaseGravityFieldComponent::DrawDebugGravityField,);
@@ -39,11 +98,18 @@ public:
 	//// Gravity state methods
 	virtual bool RequiresConstantGravityUpdate() const PURE_VIRTUAL(UBaseGravityFieldComponent::RequiresConstantGravityUpdate, return false;);
 	virtual FVector CalculateGravityVector(const FVector& TargetLocation) const PURE_VIRTUAL(UBaseGravityFieldComponent::CalculateGravityVector, return FVector::ZeroVector;);
+	virtual void CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const;
 
 	//// Gravity field methods
 	void UpdateFieldDimensions();
+	void RebuildFieldSnapshot();
 	virtual void UpdateGravityVolume() PURE_VIRTUAL(UBaseGravityFieldComponent::UpdateGravityVolume, );
 	float GetTotalGravityRadius() const;
+	virtual FBox GetFieldBounds() const;
+	bool IsLocationInGravityField(const FVector& Location) const;
+	bool CalculateSurfaceContact(const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal) const;
+	void SetGravityFieldPriority(int32 NewGravityFieldPriority);
+	void MarkGravityFieldDirty(EGravityFieldDirtyFlags DirtyFlags);
 
 	//// Overlap methods
 	UFUNCTION()
@@ -59,15 +125,18 @@ public:
 	FORCEINLINE float GetGravityStrength() const { return GravityStrength; }
 	FORCEINLINE int32 GetGravityFieldPriority() const { return GravityFieldPriority; }
 	FORCEINLINE float GetGravityInfluenceRange() const { return GravityInfluenceRange; }
+	FORCEINLINE const FGravityFieldSnapshot& GetFieldSnapshot() const { return FieldSnapshot; }
+	FORCEINLINE FGravityFieldHandle GetGravityFieldHandle() const { return RegistryHandle; }
+	FORCEINLINE uint32 GetFieldVersion() const { return FieldVersion; }
 
 	//// Setters accessors
-	FORCEINLINE void SetGravityStrength(float NewGravityStrength) { GravityStrength = NewGravityStrength; }
-	FORCEINLINE void SetGravityFieldPriority(int32 NewGravityFieldPriority) { GravityFieldPriority = NewGravityFieldPriority; }
-	FORCEINLINE void SetGravityInfluenceRange(float NewGravityRadius) { GravityInfluenceRange = NewGravityRadius; }
+	FORCEINLINE void SetGravityStrength(float NewGravityStrength) { GravityStrength = NewGravityStrength; FieldSnapshot.GravityStrength = NewGravityStrength; BumpFieldVersion(); MarkGravityFieldDirty(EGravityFieldDirtyFlags::Scene); }
+	FORCEINLINE void SetGravityInfluenceRange(float NewGravityRadius) { GravityInfluenceRange = NewGravityRadius; MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions); }
 
 protected:
 	//////// UNREAL LIFECYCLE ////////
 	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 
 	//////// STRUCTS ////////
 	struct FGravityFieldDimensions
@@ -82,6 +151,7 @@ protected:
 	int32 GravityFieldPriority;
 	float GravityInfluenceRange;
 	FGravityFieldDimensions CurrentDimensions;
+	FGravityFieldSnapshot FieldSnapshot;
 
 	//// Gravity fields
 	TUniquePtr<GravityFieldDrawer> currentDrawer;
@@ -93,4 +163,34 @@ protected:
 	//////// METHODS ////////
 	//// Gravity field methods
 	virtual FGravityFieldDimensions CalculateFieldDimensions() const PURE_VIRTUAL(UBaseGravityFieldComponent::CalculateFieldDimensions, return FGravityFieldDimensions(););
+	virtual void FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const PURE_VIRTUAL(UBaseGravityFieldComponent::FillFieldSnapshot, );
+	virtual void FillFieldSnapshotTransform(FGravityFieldSnapshot& Snapshot) const;
+	TSharedPtr<const FGravityFieldCache, ESPMode::ThreadSafe> BuildGravityCache(const FGravityFieldSnapshot& Snapshot) const;
+	bool ShouldBakeGravityCache() const;
+
+private:
+	//////// FRIENDS ////////
+	friend class UGravityWorldSubsystem;
+
+	//////// FIELDS ////////
+	//// Registry fields
+	FGravityFieldHandle RegistryHandle;
+
+	//// Version fields
+	uint32 FieldVersion = 0;
+	EGravityFieldDirtyFlags PendingDirtyFlags = EGravityFieldDirtyFlags::None;
+
+	//// Kinematic fields
+	FVector DimensionsScale = FVector::OneVector;
+	bool bMovedDuringPlay = false; // Set on the first transform change after BeginPlay, a moving field stops baking its cache
+	FTransform DebugDrawTransform = FTransform::Identity;
+
+	//////// METHODS ////////
+	//// Dirty methods
+	EGravityFieldDirtyFlags FlushDirtyState();
+	void UpdateSnapshotTransform();
+
+	//////// INLINE METHODS ////////
+	//// Version methods
+	FORCEINLINE void BumpFieldVersion() { FieldSnapshot.Version = ++FieldVersion; }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#include "CubeGravityFieldComponent.h"
 #include "Components/BoxComponent.h"
+#include "MGG/GravityFields/GravityKernels.h"
 
 /**
  * @brief Constructor for the cube gravity field component.
@@ -66,34 +67,91 @@ void UCubeGravityFieldComponent::DrawDebugGravityField()
  */
 FVector UCubeGravityFieldComponent::CalculateGravityVector(const FVector& TargetLocation) const
 {
-	FVector RelativePosition = TargetLocation - CurrentDimensions.Center;
+	return TGravityKernel<EGravityFieldShape::Cube>::EvaluateCached(FieldSnapshot, TargetLocation);
+}
+
+/**
+ * @brief Calculates the gravity vectors for a batch of target locations.
+ *
+ * @details Runs the same face/edge/corner logic as CalculateGravityVector for each point,
+ * reading the cube center and mesh extent from the field snapshot.
+ *
+ * @param PositionsX The X coordinates of the target locations.
+ * @param PositionsY The Y coordinates of the target locations.
+ * @param PositionsZ The Z coordinates of the target locations.
+ * @param OutGravityVectors Receives one gravity vector per target location.
+ */
+void UCubeGravityFieldComponent::CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const
+{
+	TGravityKernel<EGravityFieldShape::Cube>::EvaluateBatch(FieldSnapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
+}
+
+/**
+ * @brief Fills the cube-specific part of the field snapshot.
+ *
+ * @details Copies the cube mesh extent so that queries no longer look up the owner's
+ * static mesh component. The cube math is done relative to the field center.
+ *
+ * @param Snapshot The snapshot being rebuilt.
+ */
+void UCubeGravityFieldComponent::FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const
+{
+	Snapshot.Shape = EGravityFieldShape::Cube;
+	Snapshot.Center = CurrentDimensions.Center;
+	Snapshot.Extent = GetMeshExtent();
+}
+
+/**
+ * @brief Refreshes the cube parameters after a rigid motion of a kinematic field.
+ *
+ * @details The cube extent is the half-size of the mesh's world bounding box, which changes
+ * when the cube rotates. It is derived again from the cached local mesh bounds, so the
+ * owner's mesh is not looked up. The center is already refreshed by the base class.
+ *
+ * @param Snapshot The snapshot being refreshed.
+ */
+void UCubeGravityFieldComponent::FillFieldSnapshotTransform(FGravityFieldSnapshot& Snapshot) const
+{
+	Snapshot.Extent = GetMeshExtent();
+}
+
+/**
+ * @brief Gets the half-extent of the owner's cube mesh.
+ *
+ * @details Computed from the mesh bounds cached by CacheMeshBounds and the current field
+ * transform, so it follows rigid motion without looking the mesh up again.
+ *
+ * @return The world-space bounding box extent of the owner's static mesh, or zero if none.
+ */
+FVector UCubeGravityFieldComponent::GetMeshExtent() const
+{
+	if (!MeshLocalBounds.IsValid)
+	{
+		return FVector::ZeroVector;
+	}
+	return MeshLocalBounds.TransformBy(MeshRelativeTransform * GetComponentTransform()).GetExtent();
+}
+
+/**
+ * @brief Caches the local bounds of the owner's cube mesh and its placement relative to the field.
+ *
+ * @details Runs whenever the field dimensions are recomputed, which is the only time the owner's
+ * static mesh component is looked up.
+ */
+void UCubeGravityFieldComponent::CacheMeshBounds()
+{
+	MeshLocalBounds = FBox(ForceInit);
+	MeshRelativeTransform = FTransform::Identity;
 
-	FVector MeshSize;
 	if (AActor* Owner = GetOwner())
 	{
-		if (UStaticMeshComponent* MeshComp = Owner->FindComponentByClass<UStaticMeshComponent>())
+		UStaticMeshComponent* MeshComp = Owner->FindComponentByClass<UStaticMeshComponent>();
+		if (MeshComp && MeshComp->GetStaticMesh())
 		{
-			MeshSize = MeshComp->Bounds.BoxExtent;
+			MeshLocalBounds = MeshComp->GetStaticMesh()->GetBoundingBox();
+			MeshRelativeTransform = MeshComp->GetComponentTransform().GetRelativeTransform(GetComponentTransform());
 		}
 	}
-	
-	FCubePositionFlags Flags = CalculatePositionFlags(RelativePosition, MeshSize);
-	
-	int32 OutsideAxesCount = (Flags.X != FCubePositionFlags::Inside ? 1 : 0) + (Flags.Y != FCubePositionFlags::Inside ? 1 : 0) + (Flags.Z != FCubePositionFlags::Inside ? 1 : 0);
-    
-	FVector GravityVector;
-	
-	if (OutsideAxesCount == 1)
-	{
-		GravityVector = ConstructGravityComponentVector(Flags, FVector(1.0f));
-	}
-	else if (OutsideAxesCount > 1)
-	{
-		FVector BlendFactors = CalculateBlendFactors(RelativePosition, MeshSize, Flags);
-		GravityVector = ConstructGravityComponentVector(Flags, BlendFactors);
-	}
-	
-	return GravityVector.GetSafeNormal() * GravityStrength;
 }
 
 /**
@@ -130,10 +188,13 @@ UBaseGravityFieldComponent::FGravityFieldDimensions UCubeGravityFieldComponent::
  * @brief Updates the collision volume of the cube gravity field.
  *
  * @details Adjusts the box-shaped collision volume to match the current dimensions
- * and orientation of the cube gravity field.
+ * and orientation of the cube gravity field, and caches the mesh bounds the new
+ * dimensions were computed from.
  */
 void UCubeGravityFieldComponent::UpdateGravityVolume()
 {
+	CacheMeshBounds();
+
 	if (UBoxComponent* CubeVolume = Cast<UBoxComponent>(GravityVolume))
 	{
 		CubeVolume->SetBoxExtent(CurrentDimensions.Size);
@@ -143,123 +204,15 @@ void UCubeGravityFieldComponent::UpdateGravityVolume()
 }
 
 /**
- * @brief Determines the position flags for a point relative to the cube.
- *
- * @details Analyzes a point's position relative to the cube along each axis (X, Y, Z)
- * and generates position flags. For each axis, the point can be:
- * - Inside: Point is between -Extent and +Extent on this axis
- * - Forward: Point is beyond +Extent on this axis
- * - Behind: Point is below -Extent on this axis
- *
- * These flags are crucial for determining which face, edge, or corner the point is closest to,
- * which directly affects the gravity direction calculation.
- *
- * @param RelativePosition The position relative to the cube's center
- * @param Extent The half-dimensions of the cube
- * @return FCubePositionFlags structure containing flags for each axis
- */
-UCubeGravityFieldComponent::FCubePositionFlags UCubeGravityFieldComponent::CalculatePositionFlags(const FVector& RelativePosition, const FVector& Extent) const
-{
-	FCubePositionFlags Flags = {FCubePositionFlags::Inside, FCubePositionFlags::Inside, FCubePositionFlags::Inside};
-    
-	if (RelativePosition.X <= -Extent.X)
-	{
-		Flags.X = FCubePositionFlags::Behind;
-	}
-	else if (RelativePosition.X >= Extent.X)
-	{
-		Flags.X = FCubePositionFlags::Forward;
-	}
-    
-	if (RelativePosition.Y <= -Extent.Y)
-	{
-		Flags.Y = FCubePositionFlags::Behind;
-	}
-	else if (RelativePosition.Y >= Extent.Y)
-	{
-		Flags.Y = FCubePositionFlags::Forward;
-	}
-    
-	if (RelativePosition.Z <= -Extent.Z)
-	{
-		Flags.Z = FCubePositionFlags::Behind;
-	}
-	else if (RelativePosition.Z >= Extent.Z)
-	{
-		Flags.Z = FCubePositionFlags::Forward;
-	}
-    
-	return Flags;
-}
-
-/**
- * @brief Calculates blend factors for smooth gravity transitions.
- *
- * @details When an object moves between different zones of the gravity field (e.g.,
- * from a face to an edge), this method calculates blend factors for each axis
- * to ensure a smooth gravity transition.
- *
- * The algorithm uses an "EdgeBlendDistance" concept that defines a transition zone
- * near the edges. The closer a point is to the center of a face, the lower the
- * factor for that axis. Conversely, the closer it is to an edge or corner,
- * the higher the factors for the corresponding axes.
- *
- * @param RelativePosition The position relative to the cube's center
- * @param Extent The half-dimensions of the cube
- * @param Flags The position flags indicating which sides of the cube the point is on
- * @return A vector containing blend factors for each axis (between 0.0 and 1.0)
- */
-FVector UCubeGravityFieldComponent::CalculateBlendFactors(const FVector& RelativePosition, const FVector& Extent, const FCubePositionFlags& Flags) const
-{
-	const float EdgeBlendDistance = Extent.X * 0.0001f;
-    
-	FVector BlendFactors;
-	
-	if (Flags.X != FCubePositionFlags::Inside)
-	{
-		float Distance = FMath::Abs(RelativePosition.X) - (Extent.X - EdgeBlendDistance);
-		BlendFactors.X = FMath::Clamp(Distance / EdgeBlendDistance, 0.0f, 1.0f);
-	}
-    
-	if (Flags.Y != FCubePositionFlags::Inside)
-	{
-		float Distance = FMath::Abs(RelativePosition.Y) - (Extent.Y - EdgeBlendDistance);
-		BlendFactors.Y = FMath::Clamp(Distance / EdgeBlendDistance, 0.0f, 1.0f);
-	}
-    
-	if (Flags.Z != FCubePositionFlags::Inside)
-	{
-		float Distance = FMath::Abs(RelativePosition.Z) - (Extent.Z - EdgeBlendDistance);
-		BlendFactors.Z = FMath::Clamp(Distance / EdgeBlendDistance, 0.0f, 1.0f);
-	}
-    
-	return BlendFactors;
-}
-
-/**
- * @brief Constructs the final gravity vector based on position flags and blend factors.
- *
- * @details Creates a gravity vector pointing inward from the appropriate cube faces:
- * - For X+ face (Forward), the vector has a negative X component
- * - For X- face (Behind), the vector has a positive X component
- * - Similarly for Y and Z faces
- *
- * The blend factors are applied to each component to weight their influence
- * on the final vector. For example, near an edge, both adjacent faces contribute
- * significantly to the gravity direction.
+ * @brief Gets the world-space bounding box of the cube gravity field.
  *
- * This approach replicates Super Mario Galaxy's behavior where gravity is always
- * perpendicular to the surface but transitions smoothly between surfaces.
+ * @details Transforms the field's box volume by the component rotation, so the bounds stay
+ * tight for cubes that are not rotated.
  *
- * @param Flags The position flags indicating which sides of the cube the point is on
- * @param Factors The blend factors for each axis (defaults to 1.0 for all axes)
- * @return The constructed gravity vector
+ * @return The world bounds of the gravity field volume.
  */
-FVector UCubeGravityFieldComponent::ConstructGravityComponentVector(const FCubePositionFlags& Flags, const FVector& Factors) const
+FBox UCubeGravityFieldComponent::GetFieldBounds() const
 {
-	return FVector(
-		Flags.X == FCubePositionFlags::Forward ? -Factors.X : Flags.X == FCubePositionFlags::Behind ? Factors.X : 0.0f,
-		Flags.Y == FCubePositionFlags::Forward ? -Factors.Y : Flags.Y == FCubePositionFlags::Behind ? Factors.Y : 0.0f,
-		Flags.Z == FCubePositionFlags::Forward ? -Factors.Z : Flags.Z == FCubePositionFlags::Behind ? Factors.Z : 0.0f
-	);
+	const FBox LocalBounds(-CurrentDimensions.Size, CurrentDimensions.Size);
+	return LocalBounds.TransformBy(FTransform(GetComponentQuat(), CurrentDimensions.Center));
 }
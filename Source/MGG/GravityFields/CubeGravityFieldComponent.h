@@ -16,6 +16,7 @@ public:
 	//////// METHODS ////////
 	//// Gravity field methods
 	virtual void UpdateGravityVolume() override;
+	virtual FBox GetFieldBounds() const override;
 
 protected:
 	//////// METHODS ////////
@@ -24,28 +25,23 @@ protected:
 
 	//// Gravity field methods
 	virtual FVector CalculateGravityVector(const FVector& TargetLocation) const override;
+	virtual void CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const override;
 	virtual FGravityFieldDimensions CalculateFieldDimensions() const override;
+	virtual void FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const override;
+	virtual void FillFieldSnapshotTransform(FGravityFieldSnapshot& Snapshot) const override;
 
 	//////// INLINE METHODS ////////
 	//// Gravity state methods
 	FORCEINLINE virtual bool RequiresConstantGravityUpdate() const override { return true; }
 
 private:
-	//////// STRUCTS ////////
-	struct FCubePositionFlags
-	{
-		static constexpr uint8 Inside = 0;
-		static constexpr uint8 Forward = 1;
-		static constexpr uint8 Behind = 2;
-        
-		uint8 X : 2;
-		uint8 Y : 2;
-		uint8 Z : 2; 
-	};
+	//////// FIELDS ////////
+	//// Mesh fields
+	FBox MeshLocalBounds = FBox(ForceInit);
+	FTransform MeshRelativeTransform = FTransform::Identity; // Mesh transform relative to the field
 
 	//////// METHODS ////////
 	//// Helper methods
-	FCubePositionFlags CalculatePositionFlags(const FVector& RelativePosition, const FVector& Extent) const;
-	FVector CalculateBlendFactors(const FVector& RelativePosition, const FVector& Extent, const FCubePositionFlags& Flags) const;
-	FVector ConstructGravityComponentVector(const FCubePositionFlags& Flags, const FVector& Factors = FVector(1.0f)) const;
+	FVector GetMeshExtent() const;
+	void CacheMeshBounds();
 };
\ No newline at end of file
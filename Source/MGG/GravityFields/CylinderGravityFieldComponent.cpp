@@ -1,5 +1,6 @@
 ﻿#include "CylinderGravityFieldComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "MGG/GravityFields/GravityKernels.h"
 
 /**
  * @brief Constructor for the cylinder gravity field component.
@@ -71,41 +72,23 @@ void UCylinderGravityFieldComponent::DrawDebugGravityField()
  */
 FVector UCylinderGravityFieldComponent::CalculateGravityVector(const FVector& TargetLocation) const
 {
-    FVector CylinderCenter = GetComponentLocation();
-    FVector UpVector = GetUpVector();
-    FVector CenterToTarget = TargetLocation - CylinderCenter;
-    
-    float ProjectionLength = FVector::DotProduct(CenterToTarget, UpVector);
-    float HalfHeight = CylinderHeight * 0.5f;
+    return TGravityKernel<EGravityFieldShape::Cylinder>::EvaluateCached(FieldSnapshot, TargetLocation);
+}
 
-    // Plane gravity ( top and bottom )
-    if (FMath::Abs(ProjectionLength) > HalfHeight)
-    {
-        if (ProjectionLength > 0)
-        {
-            // Bottom
-            return -UpVector * GravityStrength;
-        }
-        else
-        {
-            // Top
-            return UpVector * GravityStrength;
-        }
-    }
-    else
-    {
-        // Radial gravity ( side )
-        FVector PointOnAxis = CylinderCenter + UpVector * ProjectionLength;
-        FVector RadialVector = TargetLocation - PointOnAxis;
-        
-        if (RadialVector.IsNearlyZero())
-        {
-            FVector ArbitraryDir = FMath::Abs(UpVector.Z) < 0.9f ? FVector(0, 0, 1) : FVector(1, 0, 0);
-            RadialVector = FVector::CrossProduct(UpVector, ArbitraryDir).GetSafeNormal();
-        }
-        
-        return -RadialVector.GetSafeNormal() * GravityStrength;
-    }
+/**
+ * @brief Calculates the gravity vectors for a batch of target locations.
+ *
+ * @details Runs the same plane/radial logic as CalculateGravityVector for each point,
+ * reading the cylinder's center and axis from the field snapshot.
+ *
+ * @param PositionsX The X coordinates of the target locations.
+ * @param PositionsY The Y coordinates of the target locations.
+ * @param PositionsZ The Z coordinates of the target locations.
+ * @param OutGravityVectors Receives one gravity vector per target location.
+ */
+void UCylinderGravityFieldComponent::CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const
+{
+    TGravityKernel<EGravityFieldShape::Cylinder>::EvaluateBatch(FieldSnapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
 }
 
 /**
@@ -145,6 +128,21 @@ UBaseGravityFieldComponent::FGravityFieldDimensions UCylinderGravityFieldCompone
     return Dimensions;
 }
 
+/**
+ * @brief Fills the cylinder-specific part of the field snapshot.
+ *
+ * @details The planet radius (the field radius without its influence range) is only used to
+ * describe the surface.
+ *
+ * @param Snapshot The snapshot being rebuilt.
+ */
+void UCylinderGravityFieldComponent::FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const
+{
+    Snapshot.Shape = EGravityFieldShape::Cylinder;
+    Snapshot.HalfHeight = CylinderHeight * 0.5f;
+    Snapshot.Radius = FMath::Max(CurrentDimensions.Size.X - GravityInfluenceRange, 0.0f);
+}
+
 /**
  * @brief Updates the collision volume of the cylinder gravity field.
  *
@@ -160,4 +158,19 @@ void UCylinderGravityFieldComponent::UpdateGravityVolume()
         CapsuleVolume->SetWorldLocation(CurrentDimensions.Center);
         CapsuleVolume->SetWorldRotation(GetComponentRotation());
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Gets the world-space bounding box of the cylinder gravity field.
+ *
+ * @details Encloses the capsule volume, whose half height is the cylinder half height
+ * plus the field radius, oriented along the component's up axis.
+ *
+ * @return The world bounds of the gravity field volume.
+ */
+FBox UCylinderGravityFieldComponent::GetFieldBounds() const
+{
+    const float Radius = CurrentDimensions.Size.X;
+    const FVector LocalExtent(Radius, Radius, CylinderHeight * 0.5f + Radius);
+    return FBox(-LocalExtent, LocalExtent).TransformBy(FTransform(GetComponentQuat(), CurrentDimensions.Center));
+}
@@ -0,0 +1,331 @@
+﻿#include "GravityFieldCache.h"
+#include "MGG/GravityFields/GravityFieldMath.h"
+#include "MGG/GravityFields/GravityFieldSnapshot.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGravityFieldCache, Log, All);
+
+/**
+ * @brief Bakes the gravity grid of a field.
+ *
+ * @details Covers the snapshot's bounds with grid corners spaced by at most CellSize
+ * (fewer corners are used if an axis would exceed MaxSamplesPerAxis), then evaluates the
+ * field's kernel on every corner in a single batch. The snapshot's strength is forced to 1
+ * so the grid stores unit directions.
+ *
+ * @param Snapshot The field snapshot to bake. Its own cache, if any, is ignored.
+ * @param InCellSize The requested distance between two grid corners.
+ */
+FGravityFieldGridCache::FGravityFieldGridCache(const FGravityFieldSnapshot& Snapshot, float InCellSize)
+	: Bounds(Snapshot.Bounds)
+{
+	const FVector BoundsSize = Bounds.GetSize();
+	const float SafeCellSize = FMath::Max(InCellSize, 1.0f);
+
+	Resolution.X = FMath::Clamp(FMath::CeilToInt32(BoundsSize.X / SafeCellSize) + 1, 2, MaxSamplesPerAxis);
+	Resolution.Y = FMath::Clamp(FMath::CeilToInt32(BoundsSize.Y / SafeCellSize) + 1, 2, MaxSamplesPerAxis);
+	Resolution.Z = FMath::Clamp(FMath::CeilToInt32(BoundsSize.Z / SafeCellSize) + 1, 2, MaxSamplesPerAxis);
+
+	CellSize = BoundsSize / FVector(Resolution - FIntVector(1));
+	InvCellSize = FVector(
+		CellSize.X > 0.0 ? 1.0 / CellSize.X : 0.0,
+		CellSize.Y > 0.0 ? 1.0 / CellSize.Y : 0.0,
+		CellSize.Z > 0.0 ? 1.0 / CellSize.Z : 0.0);
+
+	const int32 NumSamples = Resolution.X * Resolution.Y * Resolution.Z;
+
+	TArray<float> PositionsX, PositionsY, PositionsZ;
+	PositionsX.SetNumUninitialized(NumSamples);
+	PositionsY.SetNumUninitialized(NumSamples);
+	PositionsZ.SetNumUninitialized(NumSamples);
+
+	for (int32 Z = 0; Z < Resolution.Z; ++Z)
+	{
+		for (int32 Y = 0; Y < Resolution.Y; ++Y)
+		{
+			for (int32 X = 0; X < Resolution.X; ++X)
+			{
+				const int32 Index = GetSampleIndex(X, Y, Z);
+				PositionsX[Index] = Bounds.Min.X + X * CellSize.X;
+				PositionsY[Index] = Bounds.Min.Y + Y * CellSize.Y;
+				PositionsZ[Index] = Bounds.Min.Z + Z * CellSize.Z;
+			}
+		}
+	}
+
+	FGravityFieldSnapshot UnitSnapshot = Snapshot;
+	UnitSnapshot.GravityStrength = 1.0f;
+	UnitSnapshot.Cache.Reset();
+
+	TArray<FVector> Directions;
+	Directions.SetNumUninitialized(NumSamples);
+	FGravityFieldMath::CalculateGravityVectors(UnitSnapshot, PositionsX, PositionsY, PositionsZ, Directions);
+
+	Samples.SetNumUninitialized(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		Samples[Index] = FVector3f(Directions[Index]);
+	}
+}
+
+/**
+ * @brief Samples the gravity grid with trilinear interpolation.
+ *
+ * @param Location The world location to sample.
+ * @param GravityStrength The current strength of the field, applied to the interpolated direction.
+ * @param OutGravityVector Receives the gravity vector if the location is inside the grid.
+ * @return True if the location is inside the grid, false if the caller must evaluate the kernel.
+ */
+bool FGravityFieldGridCache::Sample(const FVector& Location, float GravityStrength, FVector& OutGravityVector) const
+{
+	if (!Bounds.IsInsideOrOn(Location))
+	{
+		return false;
+	}
+
+	const FVector GridLocation = (Location - Bounds.Min) * InvCellSize;
+
+	const int32 X0 = FMath::Clamp(FMath::FloorToInt32(GridLocation.X), 0, Resolution.X - 2);
+	const int32 Y0 = FMath::Clamp(FMath::FloorToInt32(GridLocation.Y), 0, Resolution.Y - 2);
+	const int32 Z0 = FMath::Clamp(FMath::FloorToInt32(GridLocation.Z), 0, Resolution.Z - 2);
+
+	const float AlphaX = FMath::Clamp(static_cast<float>(GridLocation.X - X0), 0.0f, 1.0f);
+	const float AlphaY = FMath::Clamp(static_cast<float>(GridLocation.Y - Y0), 0.0f, 1.0f);
+	const float AlphaZ = FMath::Clamp(static_cast<float>(GridLocation.Z - Z0), 0.0f, 1.0f);
+
+	const FVector3f C00 = FMath::Lerp(Samples[GetSampleIndex(X0, Y0, Z0)], Samples[GetSampleIndex(X0 + 1, Y0, Z0)], AlphaX);
+	const FVector3f C10 = FMath::Lerp(Samples[GetSampleIndex(X0, Y0 + 1, Z0)], Samples[GetSampleIndex(X0 + 1, Y0 + 1, Z0)], AlphaX);
+	const FVector3f C01 = FMath::Lerp(Samples[GetSampleIndex(X0, Y0, Z0 + 1)], Samples[GetSampleIndex(X0 + 1, Y0, Z0 + 1)], AlphaX);
+	const FVector3f C11 = FMath::Lerp(Samples[GetSampleIndex(X0, Y0 + 1, Z0 + 1)], Samples[GetSampleIndex(X0 + 1, Y0 + 1, Z0 + 1)], AlphaX);
+
+	const FVector3f Direction = FMath::Lerp(FMath::Lerp(C00, C10, AlphaY), FMath::Lerp(C01, C11, AlphaY), AlphaZ);
+
+	OutGravityVector = FVector(Direction.GetSafeNormal()) * GravityStrength;
+	return true;
+}
+
+/**
+ * @brief Returns the memory used by the grid samples.
+ *
+ * @return The allocated size in bytes.
+ */
+SIZE_T FGravityFieldGridCache::GetAllocatedSize() const
+{
+	return Samples.GetAllocatedSize();
+}
+
+/**
+ * @brief Bakes the sparse octree of a field.
+ *
+ * @details Cells are refined breadth first, so when the node budget runs out the resolution is
+ * spread evenly over the field instead of being spent on its first octant. Once built, the
+ * report holding the memory used and the worst error of the leaves is logged at Verbose level
+ * ("log LogGravityFieldCache Verbose" to display it).
+ *
+ * @param Snapshot The field snapshot to bake. Its own cache, if any, is ignored.
+ * @param Settings The refinement tolerances and limits.
+ */
+FGravityFieldOctreeCache::FGravityFieldOctreeCache(const FGravityFieldSnapshot& Snapshot, const FGravityFieldOctreeSettings& Settings)
+	: Bounds(Snapshot.Bounds)
+{
+	FGravityFieldSnapshot UnitSnapshot = Snapshot;
+	UnitSnapshot.GravityStrength = 1.0f;
+	UnitSnapshot.Cache.Reset();
+
+	TArray<FBuildCell> PendingCells;
+	PendingCells.Add({ 0, Bounds, 0 });
+	Nodes.Add(0);
+
+	for (int32 CellIndex = 0; CellIndex < PendingCells.Num(); ++CellIndex)
+	{
+		const FBuildCell Cell = PendingCells[CellIndex];
+		BuildCell(Cell, UnitSnapshot, Settings, PendingCells);
+	}
+
+	Nodes.Shrink();
+	Corners.Shrink();
+
+	Report.NumNodes = Nodes.Num();
+	Report.AllocatedSize = GetAllocatedSize();
+
+	UE_LOG(LogGravityFieldCache, Verbose, TEXT("Gravity octree cache: %d nodes, %d leaves, depth %d, %.1f KB, max error %.2f deg / %.3f"),
+		Report.NumNodes, Report.NumLeaves, Report.MaxDepthReached, Report.AllocatedSize / 1024.0f, Report.MaxAngularError, Report.MaxMagnitudeError);
+}
+
+/**
+ * @brief Samples the octree: finds the leaf containing the location and interpolates its corners.
+ *
+ * @param Location The world location to sample.
+ * @param GravityStrength The current strength of the field, applied to the interpolated direction.
+ * @param OutGravityVector Receives the gravity vector if the location is inside the octree.
+ * @return True if the location is inside the octree, false if the caller must evaluate the kernel.
+ */
+bool FGravityFieldOctreeCache::Sample(const FVector& Location, float GravityStrength, FVector& OutGravityVector) const
+{
+	if (!Bounds.IsInsideOrOn(Location))
+	{
+		return false;
+	}
+
+	FVector CellMin = Bounds.Min;
+	FVector CellMax = Bounds.Max;
+	uint32 Node = Nodes[0];
+
+	while (!(Node & LeafFlag))
+	{
+		const FVector CellCenter = (CellMin + CellMax) * 0.5;
+		int32 Child = 0;
+
+		if (Location.X >= CellCenter.X) { Child |= 1; CellMin.X = CellCenter.X; } else { CellMax.X = CellCenter.X; }
+		if (Location.Y >= CellCenter.Y) { Child |= 2; CellMin.Y = CellCenter.Y; } else { CellMax.Y = CellCenter.Y; }
+		if (Location.Z >= CellCenter.Z) { Child |= 4; CellMin.Z = CellCenter.Z; } else { CellMax.Z = CellCenter.Z; }
+
+		Node = Nodes[Node + Child];
+	}
+
+	const int32 FirstCorner = Node & ~LeafFlag;
+	FVector3f CornerDirections[8];
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		CornerDirections[Corner] = UnpackDirection(Corners[FirstCorner + Corner]);
+	}
+
+	const FVector CellSize = CellMax - CellMin;
+	const FVector3f Alpha(
+		CellSize.X > 0.0 ? FMath::Clamp(static_cast<float>((Location.X - CellMin.X) / CellSize.X), 0.0f, 1.0f) : 0.0f,
+		CellSize.Y > 0.0 ? FMath::Clamp(static_cast<float>((Location.Y - CellMin.Y) / CellSize.Y), 0.0f, 1.0f) : 0.0f,
+		CellSize.Z > 0.0 ? FMath::Clamp(static_cast<float>((Location.Z - CellMin.Z) / CellSize.Z), 0.0f, 1.0f) : 0.0f);
+
+	OutGravityVector = FVector(InterpolateCorners(CornerDirections, Alpha).GetSafeNormal()) * GravityStrength;
+	return true;
+}
+
+/**
+ * @brief Returns the memory used by the octree nodes and leaf corners.
+ *
+ * @return The allocated size in bytes.
+ */
+SIZE_T FGravityFieldOctreeCache::GetAllocatedSize() const
+{
+	return Nodes.GetAllocatedSize() + Corners.GetAllocatedSize();
+}
+
+/**
+ * @brief Evaluates one cell and either splits it or stores it as a leaf.
+ *
+ * @details The kernel is evaluated on the eight corners, then compared to the trilinear
+ * interpolation of those corners at the cell center and at the six face centers.
+ * The cell is split when one of the test points exceeds a tolerance (or the cell is above
+ * MinDepth), as long as MaxDepth and the node budget allow it.
+ *
+ * @param Cell The cell to evaluate, its node already allocated.
+ * @param UnitSnapshot The field snapshot with a unit strength.
+ * @param Settings The refinement tolerances and limits.
+ * @param PendingCells Receives the children of the cell when it is split.
+ */
+void FGravityFieldOctreeCache::BuildCell(const FBuildCell& Cell, const FGravityFieldSnapshot& UnitSnapshot, const FGravityFieldOctreeSettings& Settings, TArray<FBuildCell>& PendingCells)
+{
+	static const FVector3f TestAlphas[] =
+	{
+		FVector3f(0.5f, 0.5f, 0.5f),
+		FVector3f(0.0f, 0.5f, 0.5f), FVector3f(1.0f, 0.5f, 0.5f),
+		FVector3f(0.5f, 0.0f, 0.5f), FVector3f(0.5f, 1.0f, 0.5f),
+		FVector3f(0.5f, 0.5f, 0.0f), FVector3f(0.5f, 0.5f, 1.0f)
+	};
+
+	const FVector CellMin = Cell.Bounds.Min;
+	const FVector CellSize = Cell.Bounds.GetSize();
+
+	FVector3f CornerDirections[8];
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const FVector CornerLocation = CellMin + CellSize * FVector(Corner & 1 ? 1.0 : 0.0, Corner & 2 ? 1.0 : 0.0, Corner & 4 ? 1.0 : 0.0);
+		CornerDirections[Corner] = FVector3f(FGravityFieldMath::CalculateGravityVector(UnitSnapshot, CornerLocation));
+	}
+
+	float AngularError = 0.0f;
+	float MagnitudeError = 0.0f;
+
+	for (const FVector3f& Alpha : TestAlphas)
+	{
+		const FVector3f Analytic = FVector3f(FGravityFieldMath::CalculateGravityVector(UnitSnapshot, CellMin + CellSize * FVector(Alpha)));
+		const FVector3f Interpolated = InterpolateCorners(CornerDirections, Alpha);
+
+		const float AnalyticSize = Analytic.Size();
+		const float InterpolatedSize = Interpolated.Size();
+		MagnitudeError = FMath::Max(MagnitudeError, FMath::Abs(InterpolatedSize - AnalyticSize));
+
+		if (AnalyticSize > KINDA_SMALL_NUMBER && InterpolatedSize > KINDA_SMALL_NUMBER)
+		{
+			const float CosAngle = FMath::Clamp(FVector3f::DotProduct(Analytic / AnalyticSize, Interpolated / InterpolatedSize), -1.0f, 1.0f);
+			AngularError = FMath::Max(AngularError, FMath::RadiansToDegrees(FMath::Acos(CosAngle)));
+		}
+	}
+
+	const bool bExceedsTolerance = AngularError > Settings.AngularTolerance || MagnitudeError > Settings.MagnitudeTolerance;
+	const bool bCanSplit = Cell.Depth < Settings.MaxDepth && Nodes.Num() + 8 <= Settings.MaxNodes;
+
+	if (bCanSplit && (Cell.Depth < Settings.MinDepth || bExceedsTolerance))
+	{
+		const int32 FirstChild = Nodes.Num();
+		Nodes.AddZeroed(8);
+		Nodes[Cell.NodeIndex] = FirstChild;
+
+		const FVector CellCenter = Cell.Bounds.GetCenter();
+		for (int32 Child = 0; Child < 8; ++Child)
+		{
+			const FVector ChildMin(Child & 1 ? CellCenter.X : CellMin.X, Child & 2 ? CellCenter.Y : CellMin.Y, Child & 4 ? CellCenter.Z : CellMin.Z);
+			const FVector ChildMax(Child & 1 ? Cell.Bounds.Max.X : CellCenter.X, Child & 2 ? Cell.Bounds.Max.Y : CellCenter.Y, Child & 4 ? Cell.Bounds.Max.Z : CellCenter.Z);
+			PendingCells.Add({ FirstChild + Child, FBox(ChildMin, ChildMax), Cell.Depth + 1 });
+		}
+		return;
+	}
+
+	Nodes[Cell.NodeIndex] = LeafFlag | static_cast<uint32>(Corners.Num());
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		Corners.Add(PackDirection(CornerDirections[Corner]));
+	}
+
+	Report.NumLeaves++;
+	Report.MaxDepthReached = FMath::Max(Report.MaxDepthReached, Cell.Depth);
+	Report.MaxAngularError = FMath::Max(Report.MaxAngularError, AngularError);
+	Report.MaxMagnitudeError = FMath::Max(Report.MaxMagnitudeError, MagnitudeError);
+}
+
+/**
+ * @brief Trilinear interpolation of the eight corners of a cell.
+ *
+ * @param CornerDirections The corner directions, indexed by X | Y << 1 | Z << 2.
+ * @param Alpha The location inside the cell, from 0 to 1 on each axis.
+ * @return The interpolated (not normalized) direction.
+ */
+FVector3f FGravityFieldOctreeCache::InterpolateCorners(const FVector3f (&CornerDirections)[8], const FVector3f& Alpha)
+{
+	const FVector3f C00 = FMath::Lerp(CornerDirections[0], CornerDirections[1], Alpha.X);
+	const FVector3f C10 = FMath::Lerp(CornerDirections[2], CornerDirections[3], Alpha.X);
+	const FVector3f C01 = FMath::Lerp(CornerDirections[4], CornerDirections[5], Alpha.X);
+	const FVector3f C11 = FMath::Lerp(CornerDirections[6], CornerDirections[7], Alpha.X);
+
+	return FMath::Lerp(FMath::Lerp(C00, C10, Alpha.Y), FMath::Lerp(C01, C11, Alpha.Y), Alpha.Z);
+}
+
+/**
+ * @brief Quantizes a unit (or zero) direction to 16 bits per axis.
+ */
+FGravityFieldOctreeCache::FPackedDirection FGravityFieldOctreeCache::PackDirection(const FVector3f& Direction)
+{
+	return {
+		static_cast<int16>(FMath::RoundToInt32(FMath::Clamp(Direction.X, -1.0f, 1.0f) * MAX_int16)),
+		static_cast<int16>(FMath::RoundToInt32(FMath::Clamp(Direction.Y, -1.0f, 1.0f) * MAX_int16)),
+		static_cast<int16>(FMath::RoundToInt32(FMath::Clamp(Direction.Z, -1.0f, 1.0f) * MAX_int16))
+	};
+}
+
+/**
+ * @brief Restores a direction quantized by PackDirection.
+ */
+FVector3f FGravityFieldOctreeCache::UnpackDirection(const FPackedDirection& Packed)
+{
+	constexpr float Scale = 1.0f / MAX_int16;
+	return FVector3f(Packed.X * Scale, Packed.Y * Scale, Packed.Z * Scale);
+}
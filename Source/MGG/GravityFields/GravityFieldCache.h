@@ -0,0 +1,165 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+//////// FORWARD DECLARATION ////////
+//// Struct
+struct FGravityFieldSnapshot;
+
+/**
+ * @brief Immutable, precomputed gravity directions of one field.
+ *
+ * @details A cache is baked from a field snapshot and then only read, so it is shared between
+ * the field component and every published gravity scene without copying or locking.
+ * Caches store unit directions: the field's current gravity strength is applied at sampling
+ * time, so strength changes never require a new bake.
+ */
+class MGG_API FGravityFieldCache
+{
+public:
+	//////// CONSTRUCTOR ////////
+	virtual ~FGravityFieldCache() = default;
+
+	//////// METHODS ////////
+	//// Query methods
+	virtual bool Sample(const FVector& Location, float GravityStrength, FVector& OutGravityVector) const = 0;
+
+	//// Stats methods
+	virtual SIZE_T GetAllocatedSize() const = 0;
+};
+
+/**
+ * @brief Gravity cache sampled on a regular 3D grid over the field's bounds.
+ *
+ * @details Gravity is evaluated once per grid corner by the field's kernel at bake time.
+ * Queries blend the eight corners of the cell containing the location (trilinear interpolation)
+ * and renormalize the result, so the runtime cost is the same for every shape.
+ * Locations outside the grid are not sampled and fall back to the analytic kernel.
+ */
+class MGG_API FGravityFieldGridCache : public FGravityFieldCache
+{
+public:
+	//////// CONSTRUCTOR ////////
+	FGravityFieldGridCache(const FGravityFieldSnapshot& Snapshot, float InCellSize);
+
+	//////// METHODS ////////
+	//// Query methods
+	virtual bool Sample(const FVector& Location, float GravityStrength, FVector& OutGravityVector) const override;
+
+	//// Stats methods
+	virtual SIZE_T GetAllocatedSize() const override;
+
+	//////// INLINE METHODS ////////
+	//// Getters accessors
+	FORCEINLINE const FIntVector& GetResolution() const { return Resolution; }
+
+	//////// FIELDS ////////
+	//// Grid settings
+	static constexpr int32 MaxSamplesPerAxis = 128;
+
+private:
+	//////// FIELDS ////////
+	//// Grid fields
+	FBox Bounds;
+	FVector CellSize;
+	FVector InvCellSize;
+	FIntVector Resolution;
+	TArray<FVector3f> Samples;
+
+	//////// INLINE METHODS ////////
+	//// Index methods
+	FORCEINLINE int32 GetSampleIndex(int32 X, int32 Y, int32 Z) const { return X + Resolution.X * (Y + Resolution.Y * Z); }
+};
+
+/**
+ * @brief Memory used versus error achieved by a baked gravity cache.
+ *
+ * @details Errors are measured against the analytic kernel at the test points of every leaf
+ * (cell center and face centers), in unit gravity: an angular error in degrees between the
+ * interpolated and analytic directions, and a magnitude error between their lengths, which
+ * grows where neighbouring directions cancel out (sphere center, cube interior).
+ */
+struct FGravityFieldCacheReport
+{
+	int32 NumNodes = 0;
+	int32 NumLeaves = 0;
+	int32 MaxDepthReached = 0;
+	SIZE_T AllocatedSize = 0;
+	float MaxAngularError = 0.0f;
+	float MaxMagnitudeError = 0.0f;
+};
+
+/**
+ * @brief Build settings of a sparse octree gravity cache.
+ */
+struct FGravityFieldOctreeSettings
+{
+	float AngularTolerance = 2.0f;		// Degrees
+	float MagnitudeTolerance = 0.05f;	// Fraction of the gravity strength
+	int32 MinDepth = 2;
+	int32 MaxDepth = 8;
+	int32 MaxNodes = 1 << 18;			// Refinement stops once the budget is spent
+};
+
+/**
+ * @brief Gravity cache stored in a sparse, adaptively refined octree over the field's bounds.
+ *
+ * @details Starting from the field's bounds, a cell is split in eight only where trilinear
+ * interpolation of its corners deviates from the analytic kernel by more than the angular or
+ * magnitude tolerance. Far from a planet, where gravity barely changes, a few large cells are
+ * enough; near cube edges or torus tubes, the cells get as small as MaxDepth allows.
+ *
+ * The layout is compact: a node is a single 32 bit word (the index of its first child, its eight
+ * children being contiguous, or the index of its corners for a leaf), and a leaf stores its eight
+ * corner directions quantized to 16 bits per axis.
+ */
+class MGG_API FGravityFieldOctreeCache : public FGravityFieldCache
+{
+public:
+	//////// CONSTRUCTOR ////////
+	FGravityFieldOctreeCache(const FGravityFieldSnapshot& Snapshot, const FGravityFieldOctreeSettings& Settings);
+
+	//////// METHODS ////////
+	//// Query methods
+	virtual bool Sample(const FVector& Location, float GravityStrength, FVector& OutGravityVector) const override;
+
+	//// Stats methods
+	virtual SIZE_T GetAllocatedSize() const override;
+
+	//////// INLINE METHODS ////////
+	//// Getters accessors
+	FORCEINLINE const FGravityFieldCacheReport& GetReport() const { return Report; }
+
+private:
+	//////// STRUCTS ////////
+	struct FPackedDirection
+	{
+		int16 X;
+		int16 Y;
+		int16 Z;
+	};
+
+	struct FBuildCell
+	{
+		int32 NodeIndex;
+		FBox Bounds;
+		int32 Depth;
+	};
+
+	//////// FIELDS ////////
+	//// Octree fields
+	static constexpr uint32 LeafFlag = 1u << 31;
+	FBox Bounds;
+	TArray<uint32> Nodes;
+	TArray<FPackedDirection> Corners;
+	FGravityFieldCacheReport Report;
+
+	//////// METHODS ////////
+	//// Build methods
+	void BuildCell(const FBuildCell& Cell, const FGravityFieldSnapshot& UnitSnapshot, const FGravityFieldOctreeSettings& Settings, TArray<FBuildCell>& PendingCells);
+
+	//// Helper methods
+	static FVector3f InterpolateCorners(const FVector3f (&CornerDirections)[8], const FVector3f& Alpha);
+	static FPackedDirection PackDirection(const FVector3f& Direction);
+	static FVector3f UnpackDirection(const FPackedDirection& Packed);
+};
@@ -0,0 +1,99 @@
+﻿#include "GravityFieldCompositor.h"
+#include "MGG/GravityFields/GravityFieldMath.h"
+
+/**
+ * @brief Calculates the blended gravity of all the fields containing a location.
+ *
+ * @details Single pass over the fields, accumulating per priority tier the weighted gravity,
+ * the sum of weights and the strongest weight (the tier coverage). The few tiers are then
+ * folded from the highest priority down: each tier contributes its coverage times what the
+ * tiers above left uncovered, and the result is normalized by the total contribution so the
+ * lowest tier present always fills the remaining share.
+ *
+ * When every containing field is exactly on its boundary (all weights zero), the gravity of the
+ * highest priority field is used, with the usual selection rule (the later field wins ties).
+ *
+ * @param Fields The field snapshots to blend, e.g. the fields of a published gravity scene.
+ * @param Location The world location to evaluate.
+ * @param OutGravityVector Receives the blended gravity vector if a field contains the location.
+ * @return True if at least one field contains the location.
+ */
+bool FGravityFieldCompositor::CompositeGravityVector(TConstArrayView<FGravityFieldSnapshot> Fields, const FVector& Location, FVector& OutGravityVector)
+{
+	struct FPriorityTier
+	{
+		int32 Priority;
+		FVector WeightedGravity;
+		float WeightSum;
+		float Coverage;
+	};
+
+	TArray<FPriorityTier, TInlineAllocator<4>> Tiers;
+	int32 TopPriority = MIN_int32;
+	FVector TopGravity = FVector::ZeroVector;
+
+	for (const FGravityFieldSnapshot& Field : Fields)
+	{
+		if (!Field.Bounds.IsInsideOrOn(Location))
+		{
+			continue;
+		}
+
+		const float Depth = FGravityFieldMath::CalculateVolumeDepth(Field, Location);
+		if (Depth < 0.0f)
+		{
+			continue;
+		}
+
+		const float Weight = Field.BlendDistance > 0.0f ? FMath::Min(Depth / Field.BlendDistance, 1.0f) : 1.0f;
+		const FVector Gravity = FGravityFieldMath::CalculateGravityVector(Field, Location);
+
+		if (Field.GravityFieldPriority >= TopPriority)
+		{
+			TopPriority = Field.GravityFieldPriority;
+			TopGravity = Gravity;
+		}
+
+		FPriorityTier* Tier = Tiers.FindByPredicate([&Field](const FPriorityTier& Candidate) { return Candidate.Priority == Field.GravityFieldPriority; });
+		if (!Tier)
+		{
+			Tier = &Tiers.Add_GetRef({ Field.GravityFieldPriority, FVector::ZeroVector, 0.0f, 0.0f });
+		}
+
+		Tier->WeightedGravity += Gravity * Weight;
+		Tier->WeightSum += Weight;
+		Tier->Coverage = FMath::Max(Tier->Coverage, Weight);
+	}
+
+	if (Tiers.Num() == 0)
+	{
+		return false;
+	}
+
+	Tiers.Sort([](const FPriorityTier& A, const FPriorityTier& B) { return A.Priority > B.Priority; });
+
+	FVector BlendedGravity = FVector::ZeroVector;
+	float TotalContribution = 0.0f;
+	float Uncovered = 1.0f;
+
+	for (const FPriorityTier& Tier : Tiers)
+	{
+		if (Tier.WeightSum <= 0.0f)
+		{
+			continue;
+		}
+
+		const float Contribution = Tier.Coverage * Uncovered;
+		BlendedGravity += Tier.WeightedGravity / Tier.WeightSum * Contribution;
+		TotalContribution += Contribution;
+		Uncovered *= 1.0f - Tier.Coverage;
+
+		if (Uncovered <= 0.0f)
+		{
+			break;
+		}
+	}
+
+	OutGravityVector = TotalContribution > KINDA_SMALL_NUMBER ? BlendedGravity / TotalContribution : TopGravity;
+	return true;
+}
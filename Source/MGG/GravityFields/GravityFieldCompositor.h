@@ -0,0 +1,24 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MGG/GravityFields/GravityFieldSnapshot.h"
+
+/**
+ * @brief Blends every gravity field overlapping a point into a single gravity vector.
+ *
+ * @details Selecting only the highest priority field makes gravity jump as soon as a volume
+ * boundary is crossed. The compositor instead walks a contiguous list of field snapshots once,
+ * evaluates each field containing the point and weights it by how deep the point lies in the
+ * field's volume (reaching full weight after the field's BlendDistance).
+ *
+ * Fields are then combined by priority tiers: fields sharing a priority are averaged by weight,
+ * and each tier covers the lower tiers in proportion to its strongest weight. Deep inside a
+ * higher priority field the result is exactly that field's gravity, and near its boundary it
+ * fades smoothly into the field underneath.
+ */
+struct MGG_API FGravityFieldCompositor
+{
+	//////// METHODS ////////
+	//// Blend methods
+	static bool CompositeGravityVector(TConstArrayView<FGravityFieldSnapshot> Fields, const FVector& Location, FVector& OutGravityVector);
+};
@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Compact, generational reference to a gravity field registered in the gravity subsystem.
+ *
+ * @details The index points into the subsystem's dense slot array and the generation must
+ * match the slot's current generation. Unregistering a field bumps its slot's generation, so
+ * every handle still referencing it stops resolving, even after the slot is reused by another
+ * field: stale references are detected by a single integer compare, with no UObject access.
+ */
+struct FGravityFieldHandle
+{
+	//////// FIELDS ////////
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	//////// INLINE METHODS ////////
+	FORCEINLINE bool IsSet() const { return Index != INDEX_NONE; }
+	FORCEINLINE void Reset() { Index = INDEX_NONE; Generation = 0; }
+
+	FORCEINLINE bool operator==(const FGravityFieldHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	FORCEINLINE bool operator!=(const FGravityFieldHandle& Other) const { return !(*this == Other); }
+
+	FORCEINLINE friend uint32 GetTypeHash(const FGravityFieldHandle& Handle) { return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation)); }
+};
@@ -0,0 +1,160 @@
+﻿#include "GravityFieldMath.h"
+#include "MGG/GravityFields/GravityKernels.h"
+#include "MGG/GravityFields/GravityStats.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gravity Batch Evaluation"), STAT_GravityBatchEvaluation, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Gravity Batch Points"), STAT_GravityBatchPoints, STATGROUP_MGGGravity);
+
+bool GGravitySimdKernels = true;
+static FAutoConsoleVariableRef CVarGravitySimdKernels(
+	TEXT("mgg.Gravity.SimdKernels"),
+	GGravitySimdKernels,
+	TEXT("Evaluates gravity batches four points at a time with the vector register kernels. Disable to time the scalar kernels."));
+
+/**
+ * @brief Calculates the gravity vector of any field snapshot.
+ *
+ * @details Dispatches on the snapshot's shape to the matching gravity kernel, which reads
+ * the field's baked cache first when it has one.
+ *
+ * @param Snapshot The field snapshot to evaluate.
+ * @param TargetLocation The location of the target for which to calculate gravity.
+ * @return The gravity vector of the field at the target location.
+ */
+FVector FGravityFieldMath::CalculateGravityVector(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+{
+	return DispatchGravityKernel(Snapshot.Shape, [&Snapshot, &TargetLocation](auto Kernel)
+	{
+		return decltype(Kernel)::EvaluateCached(Snapshot, TargetLocation);
+	});
+}
+
+/**
+ * @brief Calculates the gravity vectors of any field snapshot for a batch of target locations.
+ *
+ * @details The kernel is selected once for the whole batch, the per-point loop then runs
+ * entirely inside the statically typed kernel. The time spent and the number of points are
+ * reported in "stat MGGGravity", the ratio of both giving the batch throughput.
+ *
+ * @param Snapshot The field snapshot to evaluate.
+ * @param PositionsX The X coordinates of the target locations.
+ * @param PositionsY The Y coordinates of the target locations.
+ * @param PositionsZ The Z coordinates of the target locations.
+ * @param OutGravityVectors Receives one gravity vector per target location.
+ */
+void FGravityFieldMath::CalculateGravityVectors(const FGravityFieldSnapshot& Snapshot, TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GravityBatchEvaluation);
+	INC_DWORD_STAT_BY(STAT_GravityBatchPoints, PositionsX.Num());
+
+	DispatchGravityKernel(Snapshot.Shape, [&](auto Kernel)
+	{
+		decltype(Kernel)::EvaluateBatch(Snapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
+	});
+}
+
+/**
+ * @brief Checks whether a world location lies inside a field's gravity volume.
+ *
+ * @details Tests the location against the volume shape mirrored in the snapshot
+ * (sphere, box or capsule), in the volume's local space.
+ *
+ * @param Snapshot The field snapshot holding the volume shape and transform.
+ * @param Location The world location to test.
+ * @return True if the location is inside the gravity volume.
+ */
+bool FGravityFieldMath::IsLocationInVolume(const FGravityFieldSnapshot& Snapshot, const FVector& Location)
+{
+	if (!Snapshot.Bounds.IsInsideOrOn(Location))
+	{
+		return false;
+	}
+
+	const FCollisionShape& VolumeShape = Snapshot.VolumeShape;
+	const FVector LocalLocation = Snapshot.VolumeTransform.InverseTransformPositionNoScale(Location);
+
+	switch (VolumeShape.ShapeType)
+	{
+	case ECollisionShape::Sphere:
+		return LocalLocation.SizeSquared() <= FMath::Square(VolumeShape.GetSphereRadius());
+
+	case ECollisionShape::Box:
+		{
+			const FVector BoxExtent = VolumeShape.GetExtent();
+			return FMath::Abs(LocalLocation.X) <= BoxExtent.X && FMath::Abs(LocalLocation.Y) <= BoxExtent.Y && FMath::Abs(LocalLocation.Z) <= BoxExtent.Z;
+		}
+
+	case ECollisionShape::Capsule:
+		{
+			const float AxisHalfLength = VolumeShape.GetCapsuleAxisHalfLength();
+			const FVector ClosestOnAxis(0.0f, 0.0f, FMath::Clamp(LocalLocation.Z, -AxisHalfLength, AxisHalfLength));
+			return FVector::DistSquared(LocalLocation, ClosestOnAxis) <= FMath::Square(VolumeShape.GetCapsuleRadius());
+		}
+
+	default:
+		return false;
+	}
+}
+
+/**
+ * @brief Calculates how deep a world location lies inside a field's gravity volume.
+ *
+ * @details The depth is the distance from the location to the closest point of the volume
+ * surface: positive inside the volume, negative outside it (for boxes, the outside value is
+ * only a lower bound of the real distance, which is enough to reject the location).
+ *
+ * @param Snapshot The field snapshot holding the volume shape and transform.
+ * @param Location The world location to test.
+ * @return The penetration depth of the location in the gravity volume.
+ */
+float FGravityFieldMath::CalculateVolumeDepth(const FGravityFieldSnapshot& Snapshot, const FVector& Location)
+{
+	const FCollisionShape& VolumeShape = Snapshot.VolumeShape;
+	const FVector LocalLocation = Snapshot.VolumeTransform.InverseTransformPositionNoScale(Location);
+
+	switch (VolumeShape.ShapeType)
+	{
+	case ECollisionShape::Sphere:
+		return VolumeShape.GetSphereRadius() - LocalLocation.Size();
+
+	case ECollisionShape::Box:
+		{
+			const FVector BoxExtent = VolumeShape.GetExtent();
+			const FVector FaceDistances = BoxExtent - LocalLocation.GetAbs();
+			return FaceDistances.GetMin();
+		}
+
+	case ECollisionShape::Capsule:
+		{
+			const float AxisHalfLength = VolumeShape.GetCapsuleAxisHalfLength();
+			const FVector ClosestOnAxis(0.0f, 0.0f, FMath::Clamp(LocalLocation.Z, -AxisHalfLength, AxisHalfLength));
+			return VolumeShape.GetCapsuleRadius() - FVector::Dist(LocalLocation, ClosestOnAxis);
+		}
+
+	default:
+		return -1.0f;
+	}
+}
+
+
+/**
+ * @brief Calculates where a world location lies relative to the planet surface of a field.
+ *
+ * @details Dispatches on the snapshot's shape to the matching kernel's surface math. This is
+ * a handful of operations and needs no physics query, but only knows the planet itself: props
+ * placed on the planet are not part of it.
+ *
+ * @param Snapshot The field snapshot to evaluate.
+ * @param Location The world location to test.
+ * @param OutSignedDistance Receives the distance to the surface: positive outside the planet, negative inside it.
+ * @param OutSurfaceNormal Receives the outward surface normal at the closest surface point.
+ * @return True if the field's shape describes a surface, false otherwise (outputs are then left untouched).
+ */
+bool FGravityFieldMath::CalculateSurfaceContact(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal)
+{
+	return DispatchGravityKernel(Snapshot.Shape, [&](auto Kernel)
+	{
+		return decltype(Kernel)::EvaluateSurface(Snapshot, Location, OutSignedDistance, OutSurfaceNormal);
+	});
+}
\ No newline at end of file
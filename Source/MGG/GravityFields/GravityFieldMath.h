@@ -0,0 +1,26 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MGG/GravityFields/GravityFieldSnapshot.h"
+
+/**
+ * @brief UObject-free gravity math evaluated on field snapshots.
+ *
+ * @details Every function here reads only the plain data of an FGravityFieldSnapshot and
+ * touches no UObject, component or world state. It can therefore be called from any thread
+ * (ParallelFor workers, UE::Tasks, the async physics thread, animation workers), as long as
+ * the snapshot itself is not modified while it is being read.
+ *
+ * The shape math itself lives in the TGravityKernel specializations (GravityKernels.h);
+ * these functions only pick the kernel matching a snapshot's shape, once per call.
+ */
+struct MGG_API FGravityFieldMath
+{
+	//////// METHODS ////////
+	//// Generic methods
+	static FVector CalculateGravityVector(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation);
+	static void CalculateGravityVectors(const FGravityFieldSnapshot& Snapshot, TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors);
+	static bool IsLocationInVolume(const FGravityFieldSnapshot& Snapshot, const FVector& Location);
+	static float CalculateVolumeDepth(const FGravityFieldSnapshot& Snapshot, const FVector& Location);
+	static bool CalculateSurfaceContact(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal);
+};
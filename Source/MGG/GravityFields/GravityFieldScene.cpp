@@ -0,0 +1,145 @@
+﻿#include "GravityFieldScene.h"
+#include "MGG/GravityFields/GravityFieldMath.h"
+#include "MGG/GravityFields/GravityFieldCompositor.h"
+
+/**
+ * @brief Finds the highest priority field containing a location.
+ *
+ * @details The scene's AABB tree returns the candidate fields, then only those run the exact
+ * volume test.
+ *
+ * @param Location The world location to test.
+ * @return The index of the active field in Fields, or INDEX_NONE if no field contains the location.
+ */
+int32 FGravityFieldScene::FindActiveFieldIndex(const FVector& Location) const
+{
+	int32 ActiveIndex = INDEX_NONE;
+
+	FieldTree.QueryPoint(Location, [this, &Location, &ActiveIndex](FGravityFieldHandle Handle)
+	{
+		const int32 FieldIndex = GetFieldIndex(Handle);
+		if (FieldIndex != INDEX_NONE && IsHigherPriorityField(FieldIndex, ActiveIndex) && FGravityFieldMath::IsLocationInVolume(Fields[FieldIndex], Location))
+		{
+			ActiveIndex = FieldIndex;
+		}
+	});
+
+	return ActiveIndex;
+}
+
+/**
+ * @brief Finds the highest priority field containing a location among a set of candidates.
+ *
+ * @details Meant for groups of nearby locations: the candidates are gathered once for the whole
+ * group with QueryFieldIndices, then each location only tests those.
+ *
+ * @param Location The world location to test.
+ * @param CandidateIndices Indices in Fields of the fields the location may be in.
+ * @return The position in CandidateIndices of the active field, or INDEX_NONE if no candidate contains the location.
+ */
+int32 FGravityFieldScene::FindActiveCandidate(const FVector& Location, TConstArrayView<int32> CandidateIndices) const
+{
+	int32 ActiveCandidate = INDEX_NONE;
+
+	for (int32 Candidate = 0; Candidate < CandidateIndices.Num(); ++Candidate)
+	{
+		const int32 FieldIndex = CandidateIndices[Candidate];
+		const int32 ActiveIndex = ActiveCandidate != INDEX_NONE ? CandidateIndices[ActiveCandidate] : INDEX_NONE;
+
+		if (IsHigherPriorityField(FieldIndex, ActiveIndex) && FGravityFieldMath::IsLocationInVolume(Fields[FieldIndex], Location))
+		{
+			ActiveCandidate = Candidate;
+		}
+	}
+
+	return ActiveCandidate;
+}
+
+/**
+ * @brief Finds the fields whose bounds intersect a box.
+ *
+ * @param Box The world box to test.
+ * @param OnCandidate Called with the index in Fields of each field whose bounds intersect the box.
+ */
+void FGravityFieldScene::QueryFieldIndices(const FBox& Box, TFunctionRef<void(int32)> OnCandidate) const
+{
+	FieldTree.QueryBox(Box, [this, &OnCandidate](FGravityFieldHandle Handle)
+	{
+		const int32 FieldIndex = GetFieldIndex(Handle);
+		if (FieldIndex != INDEX_NONE)
+		{
+			OnCandidate(FieldIndex);
+		}
+	});
+}
+
+/**
+ * @brief Calculates the gravity of the active field at a location.
+ *
+ * @param Location The world location to evaluate.
+ * @param OutGravityVector Receives the gravity vector if a field contains the location.
+ * @return True if a field contains the location.
+ */
+bool FGravityFieldScene::CalculateGravityVector(const FVector& Location, FVector& OutGravityVector) const
+{
+	const int32 ActiveIndex = FindActiveFieldIndex(Location);
+	if (ActiveIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutGravityVector = FGravityFieldMath::CalculateGravityVector(Fields[ActiveIndex], Location);
+	return true;
+}
+
+/**
+ * @brief Gets the index in Fields of a registered field.
+ *
+ * @param Handle The registry handle of the field.
+ * @return The index of the field in Fields, or INDEX_NONE if the field is not in this scene.
+ */
+int32 FGravityFieldScene::GetFieldIndex(FGravityFieldHandle Handle) const
+{
+	const int32 FieldIndex = FieldIndexBySlot.IsValidIndex(Handle.Index) ? FieldIndexBySlot[Handle.Index] : INDEX_NONE;
+	return FieldIndex != INDEX_NONE && FieldHandles[FieldIndex] == Handle ? FieldIndex : INDEX_NONE;
+}
+
+/**
+ * @brief Checks whether a candidate field should replace the current active field.
+ *
+ * @param CandidateIndex The index in Fields of the field being considered.
+ * @param CurrentIndex The index in Fields of the currently selected field, may be INDEX_NONE.
+ * @return True if the candidate has a higher priority, or the same priority and a later registration.
+ */
+bool FGravityFieldScene::IsHigherPriorityField(int32 CandidateIndex, int32 CurrentIndex) const
+{
+	if (CurrentIndex == INDEX_NONE)
+	{
+		return true;
+	}
+
+	const int32 CandidatePriority = Fields[CandidateIndex].GravityFieldPriority;
+	const int32 CurrentPriority = Fields[CurrentIndex].GravityFieldPriority;
+
+	if (CandidatePriority != CurrentPriority)
+	{
+		return CandidatePriority > CurrentPriority;
+	}
+
+	return CandidateIndex > CurrentIndex;
+}
+
+/**
+ * @brief Calculates the blended gravity of every field containing a location.
+ *
+ * @details Unlike CalculateGravityVector, which only evaluates the active field, this blends
+ * all the fields containing the location in a single pass over the scene (see FGravityFieldCompositor).
+ *
+ * @param Location The world location to evaluate.
+ * @param OutGravityVector Receives the blended gravity vector if a field contains the location.
+ * @return True if a field contains the location.
+ */
+bool FGravityFieldScene::CompositeGravityVector(const FVector& Location, FVector& OutGravityVector) const
+{
+	return FGravityFieldCompositor::CompositeGravityVector(Fields, Location, OutGravityVector);
+}
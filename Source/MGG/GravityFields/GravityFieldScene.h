@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MGG/GravityFields/GravityFieldSnapshot.h"
+#include "MGG/GravityFields/GravityFieldHandle.h"
+#include "MGG/Utils/Spatial/GravityFieldAABBTree.h"
+
+/**
+ * @brief Immutable, UObject-free copy of every gravity field of a world.
+ *
+ * @details The gravity subsystem publishes a new scene at a fixed point of the frame
+ * (the start of the world tick) from the snapshots of its registered fields. Once published,
+ * a scene is never modified, so any number of threads can query it concurrently while the
+ * game thread keeps mutating the field components.
+ *
+ * Fields are stored contiguously in registration order, which preserves the selection rule
+ * used everywhere else: the highest priority wins and, on a tie, the latest registered field wins.
+ * FieldHandles runs parallel to Fields, so a query result can be traced back to its registered field.
+ *
+ * The scene also holds a copy of the subsystem's AABB tree as it was when the scene was published,
+ * so location queries only run the exact volume test on the fields whose bounds contain them.
+ */
+struct MGG_API FGravityFieldScene
+{
+	//////// FIELDS ////////
+	//// Scene fields
+	TArray<FGravityFieldSnapshot> Fields;
+	TArray<FGravityFieldHandle> FieldHandles;
+
+	//// Spatial index fields
+	FGravityFieldAABBTree FieldTree;
+	TArray<int32> FieldIndexBySlot; // Index in Fields of each registry slot, INDEX_NONE for free slots
+
+	//////// METHODS ////////
+	//// Query methods
+	int32 FindActiveFieldIndex(const FVector& Location) const;
+	int32 FindActiveCandidate(const FVector& Location, TConstArrayView<int32> CandidateIndices) const;
+	void QueryFieldIndices(const FBox& Box, TFunctionRef<void(int32)> OnCandidate) const;
+	bool CalculateGravityVector(const FVector& Location, FVector& OutGravityVector) const;
+	bool CompositeGravityVector(const FVector& Location, FVector& OutGravityVector) const;
+
+	//// Handle methods
+	int32 GetFieldIndex(FGravityFieldHandle Handle) const;
+
+private:
+	//////// METHODS ////////
+	//// Helper methods
+	bool IsHigherPriorityField(int32 CandidateIndex, int32 CurrentIndex) const;
+};
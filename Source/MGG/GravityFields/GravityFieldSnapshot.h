@@ -0,0 +1,73 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionShape.h"
+
+//////// FORWARD DECLARATION ////////
+//// Class
+class FGravityFieldCache;
+
+/**
+ * @brief Identifies the shape math used to evaluate a gravity field.
+ */
+enum class EGravityFieldShape : uint8
+{
+	None,
+	Sphere,
+	Plane,
+	Cylinder,
+	Cube,
+	Torus
+};
+
+/**
+ * @brief Immutable copy of everything a gravity field needs to evaluate a query.
+ *
+ * @details The snapshot is rebuilt by the owning gravity field only when something that
+ * affects gravity changes (dimensions, transform or gravity settings). Gravity queries then
+ * read nothing but this plain data, so the hot path performs no component lookup, cast or
+ * transform access.
+ *
+ * Not every member is used by every shape:
+ * - Sphere: Center, Radius (planet surface only)
+ * - Plane: UpVector, Center and HalfHeight (planet surface only, half thickness of the plane)
+ * - Cylinder: Center, UpVector, HalfHeight, Radius (planet surface only)
+ * - Cube: Center, Extent
+ * - Torus: Center, Rotation, Radius, TubeRadius
+ *
+ * The gravity volume (shape, transform and bounds) is mirrored as well, so membership
+ * tests can also run without touching the volume component.
+ *
+ * A field with a baked cache shares it through the snapshot, the kernels then sample the
+ * cache instead of running the shape math wherever the cache covers the query.
+ *
+ * Version changes every time the field's gravity may have changed, so a gravity sample taken
+ * from this field can be reused for as long as the version it was taken with is current.
+ */
+struct FGravityFieldSnapshot
+{
+	//////// FIELDS ////////
+	//// Shape fields
+	EGravityFieldShape Shape = EGravityFieldShape::None;
+	FVector Center = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector UpVector = FVector::UpVector;
+	FVector Extent = FVector::ZeroVector;
+	float Radius = 0.0f;
+	float TubeRadius = 0.0f;
+	float HalfHeight = 0.0f;
+
+	//// Volume fields
+	FTransform VolumeTransform = FTransform::Identity;
+	FCollisionShape VolumeShape;
+	FBox Bounds = FBox(ForceInit);
+
+	//// Gravity fields
+	float GravityStrength = 0.0f;
+	int32 GravityFieldPriority = 0;
+	float BlendDistance = 0.0f;
+	uint32 Version = 0;
+
+	//// Cache fields
+	TSharedPtr<const FGravityFieldCache, ESPMode::ThreadSafe> Cache;
+};
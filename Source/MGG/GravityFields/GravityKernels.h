@@ -0,0 +1,620 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MGG/GravityFields/GravityFieldSnapshot.h"
+#include "MGG/GravityFields/GravityKernelsSimd.h"
+#include "MGG/GravityFields/GravityFieldCache.h"
+
+/**
+ * @brief Compile-time specialized gravity math, one kernel per field shape.
+ *
+ * @details Each TGravityKernel specialization holds the math of one shape as inline static
+ * functions reading only an FGravityFieldSnapshot. Because the shape is a template argument,
+ * a batch loop over a kernel contains no virtual call and no per-point switch: the compiler
+ * sees the whole loop body and is free to inline and vectorize it.
+ *
+ * Kernels also describe the planet surface their field wraps: EvaluateSurface gives the signed
+ * distance from a location to that surface and the surface normal at the closest point, so
+ * grounding, snapping and slope alignment need no physics query against the planet.
+ *
+ * The kernel is chosen once per batch, either statically by a shape component that knows its
+ * own shape, or dynamically through DispatchGravityKernel for code holding a generic snapshot.
+ * Nothing here needs a UWorld or a UObject, so the kernels can be exercised and timed in isolation.
+ */
+template <EGravityFieldShape Shape>
+struct TGravityKernel;
+
+/**
+ * @brief Shared batch loop of every gravity kernel.
+ *
+ * @details Evaluates a structure-of-arrays batch. Kernels declaring bHasLaneKernel evaluate
+ * four points at a time with their EvaluateLanes (see FGravitySimd), the remaining points go
+ * through the derived kernel's scalar Evaluate. Kernels with a cheaper batch form
+ * (e.g. uniform gravity) hide this function.
+ *
+ * EvaluateCached and the batch first read the snapshot's baked cache when it has one, and
+ * only run the shape math for locations the cache does not cover.
+ *
+ * Kernels without a known surface keep the default EvaluateSurface, which reports none.
+ */
+template <typename KernelType>
+struct TGravityKernelBase
+{
+	//////// FIELDS ////////
+	static constexpr bool bHasLaneKernel = false;
+
+	//////// METHODS ////////
+	//// Surface methods
+	static FORCEINLINE bool EvaluateSurface(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal)
+	{
+		return false;
+	}
+
+	//// Cached methods
+	static FORCEINLINE FVector EvaluateCached(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+	{
+		FVector CachedGravity;
+		if (Snapshot.Cache && Snapshot.Cache->Sample(TargetLocation, Snapshot.GravityStrength, CachedGravity))
+		{
+			return CachedGravity;
+		}
+
+		return KernelType::Evaluate(Snapshot, TargetLocation);
+	}
+
+	//// Batch methods
+	static FORCEINLINE void EvaluateBatch(const FGravityFieldSnapshot& Snapshot, TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors)
+	{
+		check(PositionsX.Num() == PositionsY.Num() && PositionsX.Num() == PositionsZ.Num());
+		check(OutGravityVectors.Num() >= PositionsX.Num());
+
+		if (Snapshot.Cache)
+		{
+			for (int32 Index = 0; Index < PositionsX.Num(); ++Index)
+			{
+				OutGravityVectors[Index] = EvaluateCached(Snapshot, FVector(PositionsX[Index], PositionsY[Index], PositionsZ[Index]));
+			}
+			return;
+		}
+
+		int32 FirstScalarIndex = 0;
+
+		if constexpr (KernelType::bHasLaneKernel)
+		{
+			if (GGravitySimdKernels)
+			{
+				FirstScalarIndex = FGravitySimd::EvaluateBatch<KernelType>(Snapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
+			}
+		}
+
+		for (int32 Index = FirstScalarIndex; Index < PositionsX.Num(); ++Index)
+		{
+			OutGravityVectors[Index] = KernelType::Evaluate(Snapshot, FVector(PositionsX[Index], PositionsY[Index], PositionsZ[Index]));
+		}
+	}
+};
+
+/**
+ * @brief Kernel of snapshots without a shape: no gravity.
+ */
+template <>
+struct TGravityKernel<EGravityFieldShape::None> : TGravityKernelBase<TGravityKernel<EGravityFieldShape::None>>
+{
+	static FORCEINLINE FVector Evaluate(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+	{
+		return FVector::ZeroVector;
+	}
+};
+
+/**
+ * @brief Sphere kernel: a pull toward the sphere's center.
+ */
+template <>
+struct TGravityKernel<EGravityFieldShape::Sphere> : TGravityKernelBase<TGravityKernel<EGravityFieldShape::Sphere>>
+{
+	static FORCEINLINE FVector Evaluate(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+	{
+		const FVector DirectionToCenter = Snapshot.Center - TargetLocation;
+		return DirectionToCenter.GetSafeNormal() * Snapshot.GravityStrength;
+	}
+
+	//// Surface kernel
+	static FORCEINLINE bool EvaluateSurface(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal)
+	{
+		if (Snapshot.Radius <= 0.0f)
+		{
+			return false;
+		}
+
+		const FVector CenterToLocation = Location - Snapshot.Center;
+		const float Distance = CenterToLocation.Size();
+
+		OutSurfaceNormal = Distance > UE_SMALL_NUMBER ? CenterToLocation / Distance : Snapshot.UpVector;
+		OutSignedDistance = Distance - Snapshot.Radius;
+		return true;
+	}
+
+	//// Lane kernel
+	static constexpr bool bHasLaneKernel = true;
+
+	struct FLaneConstants
+	{
+		VectorRegister4Float CenterX, CenterY, CenterZ;
+		VectorRegister4Float Strength;
+	};
+
+	static FORCEINLINE FLaneConstants MakeLaneConstants(const FGravityFieldSnapshot& Snapshot)
+	{
+		return { FGravitySimd::Splat(Snapshot.Center.X), FGravitySimd::Splat(Snapshot.Center.Y), FGravitySimd::Splat(Snapshot.Center.Z), FGravitySimd::Splat(Snapshot.GravityStrength) };
+	}
+
+	static FORCEINLINE FGravityLanes EvaluateLanes(const FLaneConstants& Constants, const FGravityLanes& Positions)
+	{
+		const FGravityLanes DirectionToCenter = { VectorSubtract(Constants.CenterX, Positions.X), VectorSubtract(Constants.CenterY, Positions.Y), VectorSubtract(Constants.CenterZ, Positions.Z) };
+		return FGravitySimd::SafeNormalScaled(DirectionToCenter, Constants.Strength);
+	}
+};
+
+/**
+ * @brief Plane kernel: a uniform pull along the plane's down axis.
+ */
+template <>
+struct TGravityKernel<EGravityFieldShape::Plane> : TGravityKernelBase<TGravityKernel<EGravityFieldShape::Plane>>
+{
+	static FORCEINLINE FVector Evaluate(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+	{
+		return -Snapshot.UpVector * Snapshot.GravityStrength;
+	}
+
+	//// Surface kernel
+	static FORCEINLINE bool EvaluateSurface(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal)
+	{
+		OutSurfaceNormal = Snapshot.UpVector;
+		OutSignedDistance = FVector::DotProduct(Location - Snapshot.Center, Snapshot.UpVector) - Snapshot.HalfHeight;
+		return true;
+	}
+
+	// Plane gravity does not depend on the location, it is computed once and broadcast.
+	static FORCEINLINE void EvaluateBatch(const FGravityFieldSnapshot& Snapshot, TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors)
+	{
+		check(PositionsX.Num() == PositionsY.Num() && PositionsX.Num() == PositionsZ.Num());
+		check(OutGravityVectors.Num() >= PositionsX.Num());
+
+		const FVector GravityVector = Evaluate(Snapshot, FVector::ZeroVector);
+
+		for (int32 Index = 0; Index < PositionsX.Num(); ++Index)
+		{
+			OutGravityVectors[Index] = GravityVector;
+		}
+	}
+};
+
+/**
+ * @brief Cylinder kernel.
+ *
+ * @details Planar gravity toward the flat faces beyond the cylinder's half height,
+ * radial gravity toward the central axis along its side.
+ */
+template <>
+struct TGravityKernel<EGravityFieldShape::Cylinder> : TGravityKernelBase<TGravityKernel<EGravityFieldShape::Cylinder>>
+{
+	static FORCEINLINE FVector Evaluate(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+	{
+		const FVector& UpVector = Snapshot.UpVector;
+		const FVector CenterToTarget = TargetLocation - Snapshot.Center;
+
+		const float ProjectionLength = FVector::DotProduct(CenterToTarget, UpVector);
+
+		// Plane gravity ( top and bottom )
+		if (FMath::Abs(ProjectionLength) > Snapshot.HalfHeight)
+		{
+			return (ProjectionLength > 0 ? -UpVector : UpVector) * Snapshot.GravityStrength;
+		}
+
+		// Radial gravity ( side )
+		FVector RadialVector = CenterToTarget - UpVector * ProjectionLength;
+
+		if (RadialVector.IsNearlyZero())
+		{
+			const FVector ArbitraryDir = FMath::Abs(UpVector.Z) < 0.9f ? FVector(0, 0, 1) : FVector(1, 0, 0);
+			RadialVector = FVector::CrossProduct(UpVector, ArbitraryDir);
+		}
+
+		return -RadialVector.GetSafeNormal() * Snapshot.GravityStrength;
+	}
+
+	//// Surface kernel
+	static FORCEINLINE bool EvaluateSurface(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal)
+	{
+		if (Snapshot.Radius <= 0.0f)
+		{
+			return false;
+		}
+
+		const FVector& UpVector = Snapshot.UpVector;
+		const FVector CenterToLocation = Location - Snapshot.Center;
+
+		const float ProjectionLength = FVector::DotProduct(CenterToLocation, UpVector);
+		const FVector RadialVector = CenterToLocation - UpVector * ProjectionLength;
+		const float RadialLength = RadialVector.Size();
+
+		const FVector RadialNormal = RadialLength > UE_SMALL_NUMBER ? RadialVector / RadialLength : FVector::CrossProduct(UpVector, FMath::Abs(UpVector.Z) < 0.9f ? FVector(0, 0, 1) : FVector(1, 0, 0));
+		const FVector CapNormal = ProjectionLength >= 0.0f ? UpVector : -UpVector;
+
+		// Distances past the side and past the flat faces
+		const float SideDistance = RadialLength - Snapshot.Radius;
+		const float CapDistance = FMath::Abs(ProjectionLength) - Snapshot.HalfHeight;
+
+		if (SideDistance > 0.0f && CapDistance > 0.0f)
+		{
+			// Past the rim: the closest point is on the edge circle
+			OutSurfaceNormal = (RadialNormal * SideDistance + CapNormal * CapDistance).GetSafeNormal();
+			OutSignedDistance = FMath::Sqrt(FMath::Square(SideDistance) + FMath::Square(CapDistance));
+		}
+		else if (SideDistance > CapDistance)
+		{
+			OutSurfaceNormal = RadialNormal;
+			OutSignedDistance = SideDistance;
+		}
+		else
+		{
+			OutSurfaceNormal = CapNormal;
+			OutSignedDistance = CapDistance;
+		}
+		return true;
+	}
+
+	//// Lane kernel
+	static constexpr bool bHasLaneKernel = true;
+
+	struct FLaneConstants
+	{
+		VectorRegister4Float CenterX, CenterY, CenterZ;
+		VectorRegister4Float UpX, UpY, UpZ;
+		VectorRegister4Float FallbackX, FallbackY, FallbackZ;
+		VectorRegister4Float HalfHeight;
+		VectorRegister4Float Strength;
+	};
+
+	static FORCEINLINE FLaneConstants MakeLaneConstants(const FGravityFieldSnapshot& Snapshot)
+	{
+		const FVector& UpVector = Snapshot.UpVector;
+		const FVector ArbitraryDir = FMath::Abs(UpVector.Z) < 0.9f ? FVector(0, 0, 1) : FVector(1, 0, 0);
+		const FVector Fallback = FVector::CrossProduct(UpVector, ArbitraryDir);
+
+		return {
+			FGravitySimd::Splat(Snapshot.Center.X), FGravitySimd::Splat(Snapshot.Center.Y), FGravitySimd::Splat(Snapshot.Center.Z),
+			FGravitySimd::Splat(UpVector.X), FGravitySimd::Splat(UpVector.Y), FGravitySimd::Splat(UpVector.Z),
+			FGravitySimd::Splat(Fallback.X), FGravitySimd::Splat(Fallback.Y), FGravitySimd::Splat(Fallback.Z),
+			FGravitySimd::Splat(Snapshot.HalfHeight),
+			FGravitySimd::Splat(Snapshot.GravityStrength)
+		};
+	}
+
+	static FORCEINLINE FGravityLanes EvaluateLanes(const FLaneConstants& Constants, const FGravityLanes& Positions)
+	{
+		const FGravityLanes CenterToTarget = { VectorSubtract(Positions.X, Constants.CenterX), VectorSubtract(Positions.Y, Constants.CenterY), VectorSubtract(Positions.Z, Constants.CenterZ) };
+		const VectorRegister4Float ProjectionLength = FGravitySimd::Dot3(CenterToTarget, Constants.UpX, Constants.UpY, Constants.UpZ);
+
+		// Plane gravity ( top and bottom ): -Up above the cylinder, +Up below it
+		const VectorRegister4Float CapMask = VectorCompareGT(VectorAbs(ProjectionLength), Constants.HalfHeight);
+		const VectorRegister4Float CapScale = VectorSelect(VectorCompareGT(ProjectionLength, VectorZeroFloat()), VectorNegate(Constants.Strength), Constants.Strength);
+		const FGravityLanes CapGravity = { VectorMultiply(Constants.UpX, CapScale), VectorMultiply(Constants.UpY, CapScale), VectorMultiply(Constants.UpZ, CapScale) };
+
+		// Radial gravity ( side ), with the same fallback as the scalar kernel on the axis itself
+		FGravityLanes RadialVector = {
+			VectorSubtract(CenterToTarget.X, VectorMultiply(Constants.UpX, ProjectionLength)),
+			VectorSubtract(CenterToTarget.Y, VectorMultiply(Constants.UpY, ProjectionLength)),
+			VectorSubtract(CenterToTarget.Z, VectorMultiply(Constants.UpZ, ProjectionLength))
+		};
+
+		const VectorRegister4Float Tolerance = VectorSetFloat1(KINDA_SMALL_NUMBER);
+		const VectorRegister4Float OnAxisMask = VectorBitwiseAnd(VectorBitwiseAnd(VectorCompareLE(VectorAbs(RadialVector.X), Tolerance), VectorCompareLE(VectorAbs(RadialVector.Y), Tolerance)), VectorCompareLE(VectorAbs(RadialVector.Z), Tolerance));
+		RadialVector = FGravitySimd::Select(OnAxisMask, { Constants.FallbackX, Constants.FallbackY, Constants.FallbackZ }, RadialVector);
+
+		const FGravityLanes RadialGravity = FGravitySimd::SafeNormalScaled(RadialVector, VectorNegate(Constants.Strength));
+
+		return FGravitySimd::Select(CapMask, CapGravity, RadialGravity);
+	}
+};
+
+/**
+ * @brief Cube kernel.
+ *
+ * @details Counts the axes on which the target is outside the cube: one axis means a face
+ * (gravity perpendicular to it), two or three mean an edge or a corner (blended gravity
+ * of the adjacent faces). For each axis, the target can be:
+ * - Inside: between -Extent and +Extent on this axis
+ * - Forward: beyond +Extent on this axis, pulled back along -axis
+ * - Behind: below -Extent on this axis, pulled back along +axis
+ *
+ * Near an edge or a corner, each outside axis is weighted by how far the target is past
+ * the blend band just inside the face, which keeps the transition between faces smooth.
+ */
+template <>
+struct TGravityKernel<EGravityFieldShape::Cube> : TGravityKernelBase<TGravityKernel<EGravityFieldShape::Cube>>
+{
+	static FORCEINLINE FVector Evaluate(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+	{
+		const FVector RelativePosition = TargetLocation - Snapshot.Center;
+		const FVector& Extent = Snapshot.Extent;
+
+		const float SignX = AxisPullSign(RelativePosition.X, Extent.X);
+		const float SignY = AxisPullSign(RelativePosition.Y, Extent.Y);
+		const float SignZ = AxisPullSign(RelativePosition.Z, Extent.Z);
+
+		const int32 OutsideAxesCount = (SignX != 0.0f ? 1 : 0) + (SignY != 0.0f ? 1 : 0) + (SignZ != 0.0f ? 1 : 0);
+
+		FVector GravityVector = FVector(SignX, SignY, SignZ);
+
+		if (OutsideAxesCount > 1)
+		{
+			const float EdgeBlendDistance = Extent.X * 0.0001f;
+			GravityVector.X *= AxisBlendFactor(RelativePosition.X, Extent.X, EdgeBlendDistance);
+			GravityVector.Y *= AxisBlendFactor(RelativePosition.Y, Extent.Y, EdgeBlendDistance);
+			GravityVector.Z *= AxisBlendFactor(RelativePosition.Z, Extent.Z, EdgeBlendDistance);
+		}
+
+		return GravityVector.GetSafeNormal() * Snapshot.GravityStrength;
+	}
+
+	//// Surface kernel
+	static FORCEINLINE bool EvaluateSurface(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal)
+	{
+		if (Snapshot.Extent.IsNearlyZero())
+		{
+			return false;
+		}
+
+		const FVector RelativePosition = Location - Snapshot.Center;
+		const FVector FaceDistances = RelativePosition.GetAbs() - Snapshot.Extent;
+		const FVector OutsideDistances = FaceDistances.ComponentMax(FVector::ZeroVector);
+
+		if (!OutsideDistances.IsZero())
+		{
+			// Outside: the closest point is on a face, an edge or a corner
+			const FVector Offset = OutsideDistances * RelativePosition.GetSignVector();
+			OutSignedDistance = Offset.Size();
+			OutSurfaceNormal = Offset / OutSignedDistance;
+			return true;
+		}
+
+		// Inside: the closest face is the one with the largest (least negative) distance
+		const int32 Axis = FaceDistances.X >= FaceDistances.Y ? (FaceDistances.X >= FaceDistances.Z ? 0 : 2) : (FaceDistances.Y >= FaceDistances.Z ? 1 : 2);
+		OutSurfaceNormal = FVector::ZeroVector;
+		OutSurfaceNormal[Axis] = RelativePosition[Axis] >= 0.0f ? 1.0f : -1.0f;
+		OutSignedDistance = FaceDistances[Axis];
+		return true;
+	}
+
+	//// Lane kernel
+	static constexpr bool bHasLaneKernel = true;
+
+	struct FLaneConstants
+	{
+		VectorRegister4Float CenterX, CenterY, CenterZ;
+		VectorRegister4Float ExtentX, ExtentY, ExtentZ;
+		VectorRegister4Float EdgeBlendDistance;
+		VectorRegister4Float Strength;
+	};
+
+	static FORCEINLINE FLaneConstants MakeLaneConstants(const FGravityFieldSnapshot& Snapshot)
+	{
+		return {
+			FGravitySimd::Splat(Snapshot.Center.X), FGravitySimd::Splat(Snapshot.Center.Y), FGravitySimd::Splat(Snapshot.Center.Z),
+			FGravitySimd::Splat(Snapshot.Extent.X), FGravitySimd::Splat(Snapshot.Extent.Y), FGravitySimd::Splat(Snapshot.Extent.Z),
+			FGravitySimd::Splat(Snapshot.Extent.X * 0.0001f),
+			FGravitySimd::Splat(Snapshot.GravityStrength)
+		};
+	}
+
+	static FORCEINLINE FGravityLanes EvaluateLanes(const FLaneConstants& Constants, const FGravityLanes& Positions)
+	{
+		const VectorRegister4Float RelativeX = VectorSubtract(Positions.X, Constants.CenterX);
+		const VectorRegister4Float RelativeY = VectorSubtract(Positions.Y, Constants.CenterY);
+		const VectorRegister4Float RelativeZ = VectorSubtract(Positions.Z, Constants.CenterZ);
+
+		const VectorRegister4Float SignX = AxisPullSignLanes(RelativeX, Constants.ExtentX);
+		const VectorRegister4Float SignY = AxisPullSignLanes(RelativeY, Constants.ExtentY);
+		const VectorRegister4Float SignZ = AxisPullSignLanes(RelativeZ, Constants.ExtentZ);
+
+		// An axis counts as outside when its pull sign is not zero
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float OutsideAxesCount = VectorAdd(VectorAdd(
+			VectorBitwiseAnd(VectorCompareNE(SignX, Zero), One),
+			VectorBitwiseAnd(VectorCompareNE(SignY, Zero), One)),
+			VectorBitwiseAnd(VectorCompareNE(SignZ, Zero), One));
+		const VectorRegister4Float EdgeMask = VectorCompareGT(OutsideAxesCount, One);
+
+		const FGravityLanes GravityVector = {
+			VectorMultiply(SignX, VectorSelect(EdgeMask, AxisBlendFactorLanes(RelativeX, Constants.ExtentX, Constants.EdgeBlendDistance), One)),
+			VectorMultiply(SignY, VectorSelect(EdgeMask, AxisBlendFactorLanes(RelativeY, Constants.ExtentY, Constants.EdgeBlendDistance), One)),
+			VectorMultiply(SignZ, VectorSelect(EdgeMask, AxisBlendFactorLanes(RelativeZ, Constants.ExtentZ, Constants.EdgeBlendDistance), One))
+		};
+
+		return FGravitySimd::SafeNormalScaled(GravityVector, Constants.Strength);
+	}
+
+private:
+	//////// METHODS ////////
+	//// Helper methods
+	static FORCEINLINE float AxisPullSign(float Position, float AxisExtent)
+	{
+		return Position >= AxisExtent ? -1.0f : Position <= -AxisExtent ? 1.0f : 0.0f;
+	}
+
+	static FORCEINLINE float AxisBlendFactor(float Position, float AxisExtent, float EdgeBlendDistance)
+	{
+		const float Distance = FMath::Abs(Position) - (AxisExtent - EdgeBlendDistance);
+		return FMath::Clamp(Distance / EdgeBlendDistance, 0.0f, 1.0f);
+	}
+
+	static FORCEINLINE VectorRegister4Float AxisPullSignLanes(const VectorRegister4Float& Position, const VectorRegister4Float& AxisExtent)
+	{
+		const VectorRegister4Float BehindSign = VectorSelect(VectorCompareLE(Position, VectorNegate(AxisExtent)), VectorOneFloat(), VectorZeroFloat());
+		return VectorSelect(VectorCompareGE(Position, AxisExtent), VectorSetFloat1(-1.0f), BehindSign);
+	}
+
+	static FORCEINLINE VectorRegister4Float AxisBlendFactorLanes(const VectorRegister4Float& Position, const VectorRegister4Float& AxisExtent, const VectorRegister4Float& EdgeBlendDistance)
+	{
+		const VectorRegister4Float Distance = VectorSubtract(VectorAbs(Position), VectorSubtract(AxisExtent, EdgeBlendDistance));
+		return VectorMin(VectorMax(VectorDivide(Distance, EdgeBlendDistance), VectorZeroFloat()), VectorOneFloat());
+	}
+};
+
+/**
+ * @brief Torus kernel: a pull perpendicular to the torus' tube.
+ *
+ * @details The target is brought into the torus' local frame, where the ring lies in the XY plane.
+ * Normalizing the planar part of the local position and scaling it by the ring radius gives the
+ * closest ring point in closed form, with no trigonometry. The closest point of the tube surface
+ * lies on the segment from that ring point to the target, so pulling toward the ring point is
+ * exactly perpendicular to the tube surface, on the outer side of the torus as well as on the
+ * inner side facing the hole, whatever the tube radius.
+ *
+ * On the torus' axis every ring point is equally close: the pull then goes toward the torus' center.
+ * A snapshot without ring radius (no torus mesh found) falls back to a pull along the field's down axis.
+ */
+template <>
+struct TGravityKernel<EGravityFieldShape::Torus> : TGravityKernelBase<TGravityKernel<EGravityFieldShape::Torus>>
+{
+	static FORCEINLINE FVector Evaluate(const FGravityFieldSnapshot& Snapshot, const FVector& TargetLocation)
+	{
+		if (Snapshot.Radius <= 0.0f)
+		{
+			return -Snapshot.UpVector * Snapshot.GravityStrength;
+		}
+
+		const FVector LocalTarget = Snapshot.Rotation.UnrotateVector(TargetLocation - Snapshot.Center);
+
+		const double PlanarSizeSquared = FMath::Square(LocalTarget.X) + FMath::Square(LocalTarget.Y);
+		const double RingScale = PlanarSizeSquared >= SMALL_NUMBER ? Snapshot.Radius * FMath::InvSqrt(PlanarSizeSquared) : 0.0;
+		const FVector LocalRingPoint(LocalTarget.X * RingScale, LocalTarget.Y * RingScale, 0.0);
+
+		const FVector TargetToRing = Snapshot.Rotation.RotateVector(LocalRingPoint - LocalTarget);
+
+		return TargetToRing.GetSafeNormal() * Snapshot.GravityStrength;
+	}
+
+	//// Surface kernel
+	static FORCEINLINE bool EvaluateSurface(const FGravityFieldSnapshot& Snapshot, const FVector& Location, float& OutSignedDistance, FVector& OutSurfaceNormal)
+	{
+		if (Snapshot.Radius <= 0.0f)
+		{
+			return false;
+		}
+
+		const FVector LocalLocation = Snapshot.Rotation.UnrotateVector(Location - Snapshot.Center);
+
+		// Same closest ring point as the gravity kernel: the tube surface lies around it
+		const double PlanarSizeSquared = FMath::Square(LocalLocation.X) + FMath::Square(LocalLocation.Y);
+		const double RingScale = PlanarSizeSquared >= SMALL_NUMBER ? Snapshot.Radius * FMath::InvSqrt(PlanarSizeSquared) : 0.0;
+		const FVector LocalRingPoint(LocalLocation.X * RingScale, LocalLocation.Y * RingScale, 0.0);
+
+		const FVector RingToLocation = Snapshot.Rotation.RotateVector(LocalLocation - LocalRingPoint);
+		const float RingDistance = RingToLocation.Size();
+
+		OutSurfaceNormal = RingDistance > UE_SMALL_NUMBER ? RingToLocation / RingDistance : Snapshot.UpVector;
+		OutSignedDistance = RingDistance - Snapshot.TubeRadius;
+		return true;
+	}
+
+	//// Lane kernel
+	static constexpr bool bHasLaneKernel = true;
+
+	struct FLaneConstants
+	{
+		VectorRegister4Float CenterX, CenterY, CenterZ;
+		VectorRegister4Float AxisXX, AxisXY, AxisXZ;
+		VectorRegister4Float AxisYX, AxisYY, AxisYZ;
+		VectorRegister4Float AxisZX, AxisZY, AxisZZ;
+		VectorRegister4Float Radius;
+		VectorRegister4Float Strength;
+		VectorRegister4Float NoRingMask;
+	};
+
+	static FORCEINLINE FLaneConstants MakeLaneConstants(const FGravityFieldSnapshot& Snapshot)
+	{
+		const FVector AxisX = Snapshot.Rotation.GetAxisX();
+		const FVector AxisY = Snapshot.Rotation.GetAxisY();
+		const FVector AxisZ = Snapshot.Rotation.GetAxisZ();
+
+		return {
+			FGravitySimd::Splat(Snapshot.Center.X), FGravitySimd::Splat(Snapshot.Center.Y), FGravitySimd::Splat(Snapshot.Center.Z),
+			FGravitySimd::Splat(AxisX.X), FGravitySimd::Splat(AxisX.Y), FGravitySimd::Splat(AxisX.Z),
+			FGravitySimd::Splat(AxisY.X), FGravitySimd::Splat(AxisY.Y), FGravitySimd::Splat(AxisY.Z),
+			FGravitySimd::Splat(AxisZ.X), FGravitySimd::Splat(AxisZ.Y), FGravitySimd::Splat(AxisZ.Z),
+			FGravitySimd::Splat(Snapshot.Radius),
+			FGravitySimd::Splat(Snapshot.GravityStrength),
+			Snapshot.Radius <= 0.0f ? VectorCompareEQ(VectorZeroFloat(), VectorZeroFloat()) : VectorZeroFloat()
+		};
+	}
+
+	static FORCEINLINE FGravityLanes EvaluateLanes(const FLaneConstants& Constants, const FGravityLanes& Positions)
+	{
+		const FGravityLanes CenterToTarget = { VectorSubtract(Positions.X, Constants.CenterX), VectorSubtract(Positions.Y, Constants.CenterY), VectorSubtract(Positions.Z, Constants.CenterZ) };
+
+		// Local frame: one dot product per torus axis
+		const VectorRegister4Float LocalX = FGravitySimd::Dot3(CenterToTarget, Constants.AxisXX, Constants.AxisXY, Constants.AxisXZ);
+		const VectorRegister4Float LocalY = FGravitySimd::Dot3(CenterToTarget, Constants.AxisYX, Constants.AxisYY, Constants.AxisYZ);
+		const VectorRegister4Float LocalZ = FGravitySimd::Dot3(CenterToTarget, Constants.AxisZX, Constants.AxisZY, Constants.AxisZZ);
+
+		// Closest ring point, collapsed to the center on the torus' axis
+		const VectorRegister4Float PlanarSizeSquared = VectorMultiplyAdd(LocalY, LocalY, VectorMultiply(LocalX, LocalX));
+		const VectorRegister4Float OffAxisMask = VectorCompareGE(PlanarSizeSquared, VectorSetFloat1(SMALL_NUMBER));
+		const VectorRegister4Float InvPlanarSize = VectorReciprocalSqrt(VectorSelect(OffAxisMask, PlanarSizeSquared, VectorOneFloat()));
+		const VectorRegister4Float RingScale = VectorSelect(OffAxisMask, VectorMultiply(Constants.Radius, InvPlanarSize), VectorZeroFloat());
+
+		const VectorRegister4Float LocalToRingX = VectorSubtract(VectorMultiply(LocalX, RingScale), LocalX);
+		const VectorRegister4Float LocalToRingY = VectorSubtract(VectorMultiply(LocalY, RingScale), LocalY);
+		const VectorRegister4Float LocalToRingZ = VectorNegate(LocalZ);
+
+		// Back to world space
+		const FGravityLanes TargetToRing = {
+			VectorMultiplyAdd(Constants.AxisZX, LocalToRingZ, VectorMultiplyAdd(Constants.AxisYX, LocalToRingY, VectorMultiply(Constants.AxisXX, LocalToRingX))),
+			VectorMultiplyAdd(Constants.AxisZY, LocalToRingZ, VectorMultiplyAdd(Constants.AxisYY, LocalToRingY, VectorMultiply(Constants.AxisXY, LocalToRingX))),
+			VectorMultiplyAdd(Constants.AxisZZ, LocalToRingZ, VectorMultiplyAdd(Constants.AxisYZ, LocalToRingY, VectorMultiply(Constants.AxisXZ, LocalToRingX)))
+		};
+
+		const VectorRegister4Float NegStrength = VectorNegate(Constants.Strength);
+		const FGravityLanes NoRingGravity = { VectorMultiply(Constants.AxisZX, NegStrength), VectorMultiply(Constants.AxisZY, NegStrength), VectorMultiply(Constants.AxisZZ, NegStrength) };
+
+		return FGravitySimd::Select(Constants.NoRingMask, NoRingGravity, FGravitySimd::SafeNormalScaled(TargetToRing, Constants.Strength));
+	}
+};
+
+/**
+ * @brief Calls a functor with the kernel matching a runtime shape.
+ *
+ * @details This is the single place where a runtime shape becomes a compile-time one. Call it
+ * once per batch and run the whole batch inside the functor, so the per-point loop stays static:
+ *
+ *     DispatchGravityKernel(Snapshot.Shape, [&](auto Kernel)
+ *     {
+ *         decltype(Kernel)::EvaluateBatch(Snapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
+ *     });
+ *
+ * @param Shape The shape of the snapshot to evaluate.
+ * @param Functor A generic callable taking a default constructed TGravityKernel<Shape>.
+ * @return Whatever the functor returns.
+ */
+template <typename FunctorType>
+FORCEINLINE decltype(auto) DispatchGravityKernel(EGravityFieldShape Shape, FunctorType&& Functor)
+{
+	switch (Shape)
+	{
+	case EGravityFieldShape::Sphere:
+		return Functor(TGravityKernel<EGravityFieldShape::Sphere>());
+	case EGravityFieldShape::Plane:
+		return Functor(TGravityKernel<EGravityFieldShape::Plane>());
+	case EGravityFieldShape::Cylinder:
+		return Functor(TGravityKernel<EGravityFieldShape::Cylinder>());
+	case EGravityFieldShape::Cube:
+		return Functor(TGravityKernel<EGravityFieldShape::Cube>());
+	case EGravityFieldShape::Torus:
+		return Functor(TGravityKernel<EGravityFieldShape::Torus>());
+	default:
+		return Functor(TGravityKernel<EGravityFieldShape::None>());
+	}
+}
@@ -0,0 +1,123 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "MGG/GravityFields/GravityFieldSnapshot.h"
+
+/**
+ * @brief Enables the 4-lane gravity kernels ("mgg.Gravity.SimdKernels").
+ *
+ * @details When disabled, every batch runs the scalar kernels, which gives a reference path
+ * to compare both the results and the "stat MGGGravity" timings against.
+ */
+extern MGG_API bool GGravitySimdKernels;
+
+/**
+ * @brief Four gravity query points, or four gravity vectors, one axis per register.
+ */
+struct FGravityLanes
+{
+	VectorRegister4Float X;
+	VectorRegister4Float Y;
+	VectorRegister4Float Z;
+};
+
+/**
+ * @brief Vector register helpers shared by the lane versions of the gravity kernels.
+ *
+ * @details The lane kernels work on VectorRegister4Float, which the engine maps to SSE on x64
+ * (VEX encoded when the target is built for AVX2) and to NEON on ARM. Every per-axis `if` of the
+ * scalar kernels becomes a comparison mask followed by a VectorSelect, so all four lanes run the
+ * same instructions whatever the position of their point.
+ */
+struct FGravitySimd
+{
+	//////// METHODS ////////
+	//// Load and store methods
+	static FORCEINLINE FGravityLanes Load(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, int32 Index)
+	{
+		return { VectorLoad(&PositionsX[Index]), VectorLoad(&PositionsY[Index]), VectorLoad(&PositionsZ[Index]) };
+	}
+
+	static FORCEINLINE void Store(const FGravityLanes& Lanes, TArrayView<FVector> OutGravityVectors, int32 Index)
+	{
+		alignas(16) float LaneX[4];
+		alignas(16) float LaneY[4];
+		alignas(16) float LaneZ[4];
+		VectorStoreAligned(Lanes.X, LaneX);
+		VectorStoreAligned(Lanes.Y, LaneY);
+		VectorStoreAligned(Lanes.Z, LaneZ);
+
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			OutGravityVectors[Index + Lane] = FVector(LaneX[Lane], LaneY[Lane], LaneZ[Lane]);
+		}
+	}
+
+	static FORCEINLINE VectorRegister4Float Splat(double Value)
+	{
+		return VectorSetFloat1(static_cast<float>(Value));
+	}
+
+	//// Math methods
+	static FORCEINLINE VectorRegister4Float Dot3(const FGravityLanes& Lanes, const VectorRegister4Float& AxisX, const VectorRegister4Float& AxisY, const VectorRegister4Float& AxisZ)
+	{
+		return VectorMultiplyAdd(Lanes.Z, AxisZ, VectorMultiplyAdd(Lanes.Y, AxisY, VectorMultiply(Lanes.X, AxisX)));
+	}
+
+	/**
+	 * @brief Lane version of FVector::GetSafeNormal() * Scale.
+	 *
+	 * @details Lanes whose squared length is below SMALL_NUMBER produce a zero vector,
+	 * exactly like the scalar GetSafeNormal.
+	 */
+	static FORCEINLINE FGravityLanes SafeNormalScaled(const FGravityLanes& Lanes, const VectorRegister4Float& Scale)
+	{
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float LengthSquared = Dot3(Lanes, Lanes.X, Lanes.Y, Lanes.Z);
+		const VectorRegister4Float ValidMask = VectorCompareGE(LengthSquared, VectorSetFloat1(SMALL_NUMBER));
+		const VectorRegister4Float InvLength = VectorReciprocalSqrt(VectorSelect(ValidMask, LengthSquared, One));
+		const VectorRegister4Float Factor = VectorSelect(ValidMask, VectorMultiply(InvLength, Scale), VectorZeroFloat());
+
+		return { VectorMultiply(Lanes.X, Factor), VectorMultiply(Lanes.Y, Factor), VectorMultiply(Lanes.Z, Factor) };
+	}
+
+	static FORCEINLINE FGravityLanes Select(const VectorRegister4Float& Mask, const FGravityLanes& A, const FGravityLanes& B)
+	{
+		return { VectorSelect(Mask, A.X, B.X), VectorSelect(Mask, A.Y, B.Y), VectorSelect(Mask, A.Z, B.Z) };
+	}
+
+	//// Batch methods
+	/**
+	 * @brief Runs a lane kernel over the largest multiple of four points of a batch.
+	 *
+	 * @details Two groups of four points are evaluated per iteration, so two independent
+	 * dependency chains are in flight and the eight points fill the pipeline the way an 8-wide
+	 * register would. The remaining zero to three points are left to the scalar kernel.
+	 *
+	 * @return The number of points evaluated.
+	 */
+	template <typename KernelType>
+	static FORCEINLINE int32 EvaluateBatch(const FGravityFieldSnapshot& Snapshot, TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors)
+	{
+		const typename KernelType::FLaneConstants Constants = KernelType::MakeLaneConstants(Snapshot);
+		const int32 NumPoints = PositionsX.Num();
+		int32 Index = 0;
+
+		for (; Index + 8 <= NumPoints; Index += 8)
+		{
+			const FGravityLanes GravityA = KernelType::EvaluateLanes(Constants, Load(PositionsX, PositionsY, PositionsZ, Index));
+			const FGravityLanes GravityB = KernelType::EvaluateLanes(Constants, Load(PositionsX, PositionsY, PositionsZ, Index + 4));
+			Store(GravityA, OutGravityVectors, Index);
+			Store(GravityB, OutGravityVectors, Index + 4);
+		}
+
+		if (Index + 4 <= NumPoints)
+		{
+			Store(KernelType::EvaluateLanes(Constants, Load(PositionsX, PositionsY, PositionsZ, Index)), OutGravityVectors, Index);
+			Index += 4;
+		}
+
+		return Index;
+	}
+};
@@ -0,0 +1,12 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/**
+ * @brief Stat group of the gravity system, displayed with "stat MGGGravity".
+ *
+ * @details Cycle and counter stats of the gravity code are declared in the translation units
+ * that own them, under this single group.
+ */
+DECLARE_STATS_GROUP(TEXT("MGG Gravity"), STATGROUP_MGGGravity, STATCAT_Advanced);
@@ -1,5 +1,6 @@
 ﻿#include "PlaneGravityFieldComponent.h"
 #include "Components/BoxComponent.h"
+#include "MGG/GravityFields/GravityKernels.h"
 
 /**
  * @brief Constructor for the plane gravity field component.
@@ -62,7 +63,23 @@ void UPlaneGravityFieldComponent::DrawDebugGravityField()
  */
 FVector UPlaneGravityFieldComponent::CalculateGravityVector(const FVector& TargetLocation) const
 {
-	return -GetUpVector() * GravityStrength;
+	return TGravityKernel<EGravityFieldShape::Plane>::EvaluateCached(FieldSnapshot, TargetLocation);
+}
+
+/**
+ * @brief Calculates the gravity vectors for a batch of target locations.
+ *
+ * @details Plane gravity is uniform, so the gravity vector is computed once and
+ * broadcast to every output slot.
+ *
+ * @param PositionsX The X coordinates of the target locations.
+ * @param PositionsY The Y coordinates of the target locations.
+ * @param PositionsZ The Z coordinates of the target locations.
+ * @param OutGravityVectors Receives one gravity vector per target location.
+ */
+void UPlaneGravityFieldComponent::CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const
+{
+	TGravityKernel<EGravityFieldShape::Plane>::EvaluateBatch(FieldSnapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
 }
 
 /**
@@ -96,6 +113,30 @@ UBaseGravityFieldComponent::FGravityFieldDimensions UPlaneGravityFieldComponent:
 	return Dimensions;
 }
 
+/**
+ * @brief Fills the plane-specific part of the field snapshot.
+ *
+ * @details The gravity only needs the plane's up vector, which the base snapshot already holds.
+ * The half thickness of the owner's mesh along that vector places the walkable surface.
+ *
+ * @param Snapshot The snapshot being rebuilt.
+ */
+void UPlaneGravityFieldComponent::FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const
+{
+	Snapshot.Shape = EGravityFieldShape::Plane;
+
+	if (AActor* Owner = GetOwner())
+	{
+		if (UStaticMeshComponent* MeshComp = Owner->FindComponentByClass<UStaticMeshComponent>())
+		{
+			if (MeshComp->GetStaticMesh())
+			{
+				Snapshot.HalfHeight = MeshComp->GetStaticMesh()->GetBoundingBox().GetExtent().Z * MeshComp->GetComponentScale().Z;
+			}
+		}
+	}
+}
+
 /**
  * @brief Updates the collision volume of the plane gravity field.
  *
@@ -138,3 +179,21 @@ void UPlaneGravityFieldComponent::UpdateGravityVolume()
 		BoxVolume->SetWorldRotation(Rotation);
 	}
 }
+
+/**
+ * @brief Gets the world-space bounding box of the plane gravity field.
+ *
+ * @details The plane volume is offset from the field center above the mesh surface
+ * (see UpdateGravityVolume), so the bounds are read from the box volume itself once it
+ * has been placed.
+ *
+ * @return The world bounds of the gravity field volume.
+ */
+FBox UPlaneGravityFieldComponent::GetFieldBounds() const
+{
+	if (GravityVolume)
+	{
+		return GravityVolume->Bounds.GetBox();
+	}
+	return Super::GetFieldBounds();
+}
@@ -1,5 +1,6 @@
 ﻿#include "SphereGravityFieldComponent.h"
 #include "Components/SphereComponent.h"
+#include "MGG/GravityFields/GravityKernels.h"
 
 /**
  * @brief Constructor for the sphere gravity field component.
@@ -58,8 +59,23 @@ void USphereGravityFieldComponent::DrawDebugGravityField()
  */
 FVector USphereGravityFieldComponent::CalculateGravityVector(const FVector& TargetLocation) const
 {
-	FVector DirectionToCenter = GetComponentLocation() - TargetLocation;
-	return DirectionToCenter.GetSafeNormal() * GravityStrength;
+	return TGravityKernel<EGravityFieldShape::Sphere>::EvaluateCached(FieldSnapshot, TargetLocation);
+}
+
+/**
+ * @brief Calculates the gravity vectors for a batch of target locations.
+ *
+ * @details Same "pull toward center" logic as CalculateGravityVector, applied to the
+ * whole batch from the field snapshot.
+ *
+ * @param PositionsX The X coordinates of the target locations.
+ * @param PositionsY The Y coordinates of the target locations.
+ * @param PositionsZ The Z coordinates of the target locations.
+ * @param OutGravityVectors Receives one gravity vector per target location.
+ */
+void USphereGravityFieldComponent::CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const
+{
+	TGravityKernel<EGravityFieldShape::Sphere>::EvaluateBatch(FieldSnapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
 }
 
 /**
@@ -92,6 +108,20 @@ UBaseGravityFieldComponent::FGravityFieldDimensions USphereGravityFieldComponent
 	return Dimensions;
 }
 
+/**
+ * @brief Fills the sphere-specific part of the field snapshot.
+ *
+ * @details The gravity only needs the sphere's center, which the base snapshot already holds.
+ * The planet radius (the field radius without its influence range) describes the surface.
+ *
+ * @param Snapshot The snapshot being rebuilt.
+ */
+void USphereGravityFieldComponent::FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const
+{
+	Snapshot.Shape = EGravityFieldShape::Sphere;
+	Snapshot.Radius = FMath::Max(CurrentDimensions.Size.X - GravityInfluenceRange, 0.0f);
+}
+
 /**
  * @brief Updates the collision volume of the sphere gravity field.
  *
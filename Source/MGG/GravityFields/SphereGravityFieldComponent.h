@@ -24,7 +24,9 @@ protected:
 
 	//// Gravity field methods
 	virtual FVector CalculateGravityVector(const FVector& TargetLocation) const override;
+	virtual void CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const override;
 	virtual FGravityFieldDimensions CalculateFieldDimensions() const override;
+	virtual void FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const override;
 
 	//////// INLINE METHODS ////////
 	//// Gravity state methods
@@ -3,6 +3,7 @@
 #include "Components/SphereComponent.h"
 #include "MGG/Planets/BasePlanet.h"
 #include "MGG/Utils/MeshGenerator/TorusMeshComponent.h"
+#include "MGG/GravityFields/GravityKernels.h"
 
 /**
  * @brief Constructor for the torus gravity field component.
@@ -12,7 +13,7 @@
  */
 UTorusGravityFieldComponent::UTorusGravityFieldComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 	
 	USphereComponent* SphereVolume = CreateDefaultSubobject<USphereComponent>(TEXT("GravityVolume"));
 	GravityVolume = SphereVolume;
@@ -64,55 +65,40 @@ void UTorusGravityFieldComponent::DrawDebugGravityField()
  * @brief Calculates the gravity vector for a given target location in a torus gravity field.
  *
  * @details This method implements the torus-specific gravity logic:
- * 1. Gets the torus parameters (center, main radius, tube radius) from the owner's mesh
- * 2. Establishes reference vectors for orientation:
- *    - 'gu' as the up vector (typically Z-axis)
- *    - 'gr' as the right vector (typically X-axis)
- * 3. Calculates the normalized direction vector from torus center to target
- * 4. Finds the point on the torus's ring that is closest to the target by:
- *    - Computing the angle between the direction vector and reference vector
- *    - Using this angle to rotate around the torus's ring
- *    - Scaling by the torus's main radius to get the exact point on the ring
- * 5. Creates a gravity vector pointing from the target toward this closest point
+ * 1. Reads the torus parameters (center, rotation, scaled main radius) from the field snapshot
+ * 2. Brings the target into the torus' local frame, where the ring lies in the XY plane
+ * 3. Finds the point on the torus's ring that is closest to the target in closed form:
+ *    the planar part of the local position, normalized and scaled by the main radius
+ * 4. Creates a gravity vector pointing from the target toward this closest point,
+ *    rotated back to world space
  * 
  * This implementation creates the distinctive "donut" gravity of a torus where:
- * - Objects are pulled toward the circular ring at the center of the torus
+ * - Gravity is perpendicular to the tube surface, on its outer side as well as on its inner side
  * - The gravity direction continuously changes as objects move around the torus
- * - Objects can orbit inside or outside the torus following the ring's curvature
+ * - The field follows the torus' own rotation
  *
  * @param TargetLocation The location of the target for which to calculate gravity
  * @return The gravity vector pointing toward the closest point on the torus's ring
  */
 FVector UTorusGravityFieldComponent::CalculateGravityVector(const FVector& TargetLocation) const
 {
-    if (AActor* Owner = GetOwner())
-    {
-	    if (UTorusMeshComponent* TorusMesh = Owner->FindComponentByClass<UTorusMeshComponent>())
-        {
-            FVector TorusCenter = GetComponentLocation();
-	    	
-            FVector gu = FVector(0, 0, 1);
-            FVector gr = FVector(1, 0, 0);
-	    	
-            float BaseRadius = TorusMesh->TorusRadius;
-            float ScaledRadius = BaseRadius * GetTorusScaleFactor();
-	    	
-            FVector V = (TargetLocation - TorusCenter).GetSafeNormal();
-	    	
-            float dotProduct = FVector::DotProduct(V, gr);
-            dotProduct = FMath::Clamp(dotProduct, -1.0f, 1.0f);
-            float angle = FMath::Acos(dotProduct);
-            float sign = FMath::Sign(FVector::DotProduct(FVector::CrossProduct(V, gr), gu));
-	    	
-            FVector rotatedGr = gr.RotateAngleAxis(angle * sign * 180.0f / PI, gu);
-            FVector P = TorusCenter + rotatedGr * ScaledRadius;
-            FVector GravityDirection = (P - TargetLocation).GetSafeNormal();
-            
-            return GravityDirection * GravityStrength;
-        }
-    }
-	
-    return FVector(0, 0, -1) * GravityStrength;
+	return TGravityKernel<EGravityFieldShape::Torus>::EvaluateCached(FieldSnapshot, TargetLocation);
+}
+
+/**
+ * @brief Calculates the gravity vectors for a batch of target locations.
+ *
+ * @details Runs the same closest-ring-point projection as CalculateGravityVector, four points
+ * at a time through the torus lane kernel.
+ *
+ * @param PositionsX The X coordinates of the target locations.
+ * @param PositionsY The Y coordinates of the target locations.
+ * @param PositionsZ The Z coordinates of the target locations.
+ * @param OutGravityVectors Receives one gravity vector per target location.
+ */
+void UTorusGravityFieldComponent::CalculateGravityVectors(TConstArrayView<float> PositionsX, TConstArrayView<float> PositionsY, TConstArrayView<float> PositionsZ, TArrayView<FVector> OutGravityVectors) const
+{
+	TGravityKernel<EGravityFieldShape::Torus>::EvaluateBatch(FieldSnapshot, PositionsX, PositionsY, PositionsZ, OutGravityVectors);
 }
 
 /**
@@ -147,6 +133,30 @@ UBaseGravityFieldComponent::FGravityFieldDimensions UTorusGravityFieldComponent:
 	return Dimensions;
 }
 
+/**
+ * @brief Fills the torus-specific part of the field snapshot.
+ *
+ * @details Resolves the procedural torus mesh and the planet scale factor once, and stores
+ * the scaled ring and tube radii. A radius of zero means no torus mesh was found, in which
+ * case queries fall back to a default downward gravity.
+ *
+ * @param Snapshot The snapshot being rebuilt.
+ */
+void UTorusGravityFieldComponent::FillFieldSnapshot(FGravityFieldSnapshot& Snapshot) const
+{
+	Snapshot.Shape = EGravityFieldShape::Torus;
+
+	if (AActor* Owner = GetOwner())
+	{
+		if (UTorusMeshComponent* TorusMesh = Owner->FindComponentByClass<UTorusMeshComponent>())
+		{
+			const float ScaleFactor = GetTorusScaleFactor();
+			Snapshot.Radius = TorusMesh->TorusRadius * ScaleFactor;
+			Snapshot.TubeRadius = TorusMesh->TubeRadius * ScaleFactor;
+		}
+	}
+}
+
 /**
  * @brief Updates the collision volume of the torus gravity field.
  *
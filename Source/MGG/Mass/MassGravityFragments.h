@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "MassExternalSubsystemTraits.h"
+#include "MGG/GravityFields/GravityFieldHandle.h"
+#include "MGG/Utils/Subsystems/GravityWorldSubsystem.h"
+#include "MassGravityFragments.generated.h"
+
+/**
+ * @brief Gravity state of a Mass entity bound to the gravity fields.
+ *
+ * @details Written once per frame by UMassGravityProcessor from the entity's FTransformFragment
+ * (the position), and read by whatever processor moves the entity. Entities outside every field
+ * keep their last gravity vector and get an unset ActiveField handle.
+ */
+USTRUCT()
+struct MGG_API FMassGravityFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	//////// FIELDS ////////
+	UPROPERTY(EditAnywhere, Category = "Gravity")
+	FVector GravityVector = FVector(0.0f, 0.0f, -980.0f);
+
+	FGravityFieldHandle ActiveField;
+};
+
+/**
+ * @brief Lets Mass processors read the gravity subsystem from worker threads.
+ *
+ * @details Mass processors only ever read the published gravity scene, which is immutable and
+ * lock protected (see UGravityWorldSubsystem::GetGravityScene).
+ */
+template<>
+struct TMassExternalSubsystemTraits<UGravityWorldSubsystem> final
+{
+	enum
+	{
+		GameThreadOnly = false,
+		ThreadSafeWrite = false,
+	};
+};
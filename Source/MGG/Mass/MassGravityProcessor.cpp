@@ -0,0 +1,205 @@
+﻿#include "MassGravityProcessor.h"
+#include "MassExecutionContext.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "Algo/BinarySearch.h"
+#include "MGG/Mass/MassGravityFragments.h"
+#include "MGG/GravityFields/GravityFieldMath.h"
+#include "MGG/GravityFields/GravityStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gravity Mass Processor"), STAT_GravityMassProcessor, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Gravity Mass Entities"), STAT_GravityMassEntities, STATGROUP_MGGGravity);
+
+/**
+ * @brief Constructor for the Mass gravity processor.
+ *
+ * @details Runs in the pre-physics phase on every net mode that simulates entities,
+ * before the movement processors that consume the gravity vectors.
+ */
+UMassGravityProcessor::UMassGravityProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = int32(EProcessorExecutionFlags::Standalone | EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Client);
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	ExecutionOrder.ExecuteBefore.Add(UE::Mass::ProcessorGroupNames::Movement);
+	bAutoRegisterWithProcessingPhases = true;
+}
+
+/**
+ * @brief Declares the fragments and subsystem the processor accesses.
+ */
+void UMassGravityProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassGravityFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddSubsystemRequirement<UGravityWorldSubsystem>(EMassFragmentAccess::ReadOnly);
+}
+
+/**
+ * @brief Updates the gravity fragment of every matching entity, one chunk at a time.
+ *
+ * @details For each chunk:
+ * 1. Queries the scene's AABB tree once with the bounds of the chunk's entities, which gives the
+ *    only fields any of them can be in
+ * 2. Selects each entity's active field among those candidates and stores its handle. Mass
+ *    chunks group entities by archetype, not by location, so scattered entities give bounds
+ *    overlapping many fields: past MaxSharedCandidates, each entity queries the tree at its own
+ *    location instead of testing every candidate
+ * 3. Counting-sorts the entities by active field, laying their positions out as
+ *    contiguous X/Y/Z arrays
+ * 4. Evaluates each field once over its whole slice with FGravityFieldMath::CalculateGravityVectors,
+ *    which runs the vectorized kernels
+ * 5. Scatters the results back to the entities' fragments
+ *
+ * Either way, an entity only runs the exact volume test on fields whose bounds are near it, so
+ * the cost of a chunk does not grow with the number of fields in the world.
+ *
+ * Scratch arrays live on the thread's memory stack, so a chunk never touches the heap.
+ *
+ * @param EntityManager The entity manager owning the entities.
+ * @param Context The execution context of this run.
+ */
+void UMassGravityProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GravityMassProcessor);
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& Context)
+	{
+		const UGravityWorldSubsystem& GravitySubsystem = Context.GetSubsystemChecked<UGravityWorldSubsystem>();
+		const TSharedPtr<const FGravityFieldScene, ESPMode::ThreadSafe> Scene = GravitySubsystem.GetGravityScene();
+
+		const int32 NumEntities = Context.GetNumEntities();
+		const TConstArrayView<FTransformFragment> TransformList = Context.GetFragmentView<FTransformFragment>();
+		const TArrayView<FMassGravityFragment> GravityList = Context.GetMutableFragmentView<FMassGravityFragment>();
+
+		INC_DWORD_STAT_BY(STAT_GravityMassEntities, NumEntities);
+
+		FMemMark MemMark(FMemStack::Get());
+
+		// Candidate fields of the whole chunk, sorted so ties keep resolving to the latest registered field
+		TArray<int32, TMemStackAllocator<>> CandidateIndices;
+
+		if (Scene && Scene->Fields.Num() > 0)
+		{
+			FBox ChunkBounds(ForceInit);
+			for (const FTransformFragment& Transform : TransformList)
+			{
+				ChunkBounds += Transform.GetTransform().GetLocation();
+			}
+
+			Scene->QueryFieldIndices(ChunkBounds, [&CandidateIndices](int32 FieldIndex) { CandidateIndices.Add(FieldIndex); });
+			CandidateIndices.Sort();
+		}
+
+		const int32 NumCandidates = CandidateIndices.Num();
+		if (NumCandidates == 0)
+		{
+			for (FMassGravityFragment& Gravity : GravityList)
+			{
+				Gravity.ActiveField.Reset();
+			}
+			return;
+		}
+
+		// Active field selection, counting how many entities each candidate owns
+		TArray<int32, TMemStackAllocator<>> ActiveCandidates;
+		ActiveCandidates.SetNumUninitialized(NumEntities);
+
+		TArray<int32, TMemStackAllocator<>> BucketOffsets;
+		BucketOffsets.SetNumZeroed(NumCandidates + 1);
+
+		const bool bQueryPerEntity = NumCandidates > MaxSharedCandidates;
+
+		for (int32 EntityIndex = 0; EntityIndex < NumEntities; ++EntityIndex)
+		{
+			const FVector Location = TransformList[EntityIndex].GetTransform().GetLocation();
+			int32 Candidate = INDEX_NONE;
+
+			if (bQueryPerEntity)
+			{
+				// The field's bounds contain the entity, so they intersect the chunk bounds and it is a candidate
+				const int32 FieldIndex = Scene->FindActiveFieldIndex(Location);
+				Candidate = FieldIndex != INDEX_NONE ? Algo::BinarySearch(CandidateIndices, FieldIndex) : INDEX_NONE;
+			}
+			else
+			{
+				Candidate = Scene->FindActiveCandidate(Location, CandidateIndices);
+			}
+
+			ActiveCandidates[EntityIndex] = Candidate;
+
+			if (Candidate == INDEX_NONE)
+			{
+				GravityList[EntityIndex].ActiveField.Reset();
+				continue;
+			}
+
+			GravityList[EntityIndex].ActiveField = Scene->FieldHandles[CandidateIndices[Candidate]];
+			++BucketOffsets[Candidate + 1];
+		}
+
+		for (int32 Candidate = 0; Candidate < NumCandidates; ++Candidate)
+		{
+			BucketOffsets[Candidate + 1] += BucketOffsets[Candidate];
+		}
+
+		const int32 NumBucketed = BucketOffsets[NumCandidates];
+		if (NumBucketed == 0)
+		{
+			return;
+		}
+
+		// Counting sort by field, laying positions out as structure of arrays
+		TArray<int32, TMemStackAllocator<>> BucketCursors(BucketOffsets.GetData(), NumCandidates);
+		TArray<int32, TMemStackAllocator<>> SortedEntities;
+		TArray<float, TMemStackAllocator<>> PositionsX;
+		TArray<float, TMemStackAllocator<>> PositionsY;
+		TArray<float, TMemStackAllocator<>> PositionsZ;
+		TArray<FVector, TMemStackAllocator<>> GravityVectors;
+		SortedEntities.SetNumUninitialized(NumBucketed);
+		PositionsX.SetNumUninitialized(NumBucketed);
+		PositionsY.SetNumUninitialized(NumBucketed);
+		PositionsZ.SetNumUninitialized(NumBucketed);
+		GravityVectors.SetNumUninitialized(NumBucketed);
+
+		for (int32 EntityIndex = 0; EntityIndex < NumEntities; ++EntityIndex)
+		{
+			const int32 Candidate = ActiveCandidates[EntityIndex];
+			if (Candidate == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const int32 SortedIndex = BucketCursors[Candidate]++;
+			const FVector Location = TransformList[EntityIndex].GetTransform().GetLocation();
+
+			SortedEntities[SortedIndex] = EntityIndex;
+			PositionsX[SortedIndex] = Location.X;
+			PositionsY[SortedIndex] = Location.Y;
+			PositionsZ[SortedIndex] = Location.Z;
+		}
+
+		// One batch per field
+		for (int32 Candidate = 0; Candidate < NumCandidates; ++Candidate)
+		{
+			const int32 Start = BucketOffsets[Candidate];
+			const int32 Count = BucketOffsets[Candidate + 1] - Start;
+			if (Count == 0)
+			{
+				continue;
+			}
+
+			FGravityFieldMath::CalculateGravityVectors(
+				Scene->Fields[CandidateIndices[Candidate]],
+				TConstArrayView<float>(PositionsX).Slice(Start, Count),
+				TConstArrayView<float>(PositionsY).Slice(Start, Count),
+				TConstArrayView<float>(PositionsZ).Slice(Start, Count),
+				TArrayView<FVector>(GravityVectors).Slice(Start, Count));
+		}
+
+		for (int32 SortedIndex = 0; SortedIndex < NumBucketed; ++SortedIndex)
+		{
+			GravityList[SortedEntities[SortedIndex]].GravityVector = GravityVectors[SortedIndex];
+		}
+	});
+}
@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "MassGravityProcessor.generated.h"
+
+/**
+ * @brief Evaluates the gravity fields for every entity carrying a FMassGravityFragment.
+ *
+ * @details Lets tens of thousands of lightweight entities (coins, star bits, critters) follow
+ * the planets' gravity without being actors, overlapping volumes or implementing IGravityAffected.
+ *
+ * Each Mass chunk is processed as a batch against the gravity scene published for this frame:
+ * 1. Every entity's active field is selected (highest priority, latest registered on a tie)
+ *    among the fields the scene's AABB tree returns for the chunk's bounds, or through its own
+ *    tree query when the chunk's entities are too spread out to share candidates
+ * 2. Entities are bucketed by active field with a counting sort
+ * 3. Each bucket is evaluated in one structure-of-arrays batch through the field's kernel
+ *
+ * The processor only reads the immutable scene, so it never has to run on the game thread.
+ */
+UCLASS()
+class MGG_API UMassGravityProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	//////// CONSTRUCTOR ////////
+	UMassGravityProcessor();
+
+protected:
+	//////// METHODS ////////
+	//// UMassProcessor implementation
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	//////// FIELDS ////////
+	FMassEntityQuery EntityQuery;
+	static constexpr int32 MaxSharedCandidates = 8; // Beyond this, each entity of the chunk queries the tree itself
+};
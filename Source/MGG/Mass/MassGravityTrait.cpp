@@ -0,0 +1,16 @@
+﻿#include "MassGravityTrait.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassCommonFragments.h"
+#include "MGG/Mass/MassGravityFragments.h"
+
+/**
+ * @brief Adds the gravity fragments to the entity template.
+ *
+ * @param BuildContext The template being built.
+ * @param World The world the template is built for.
+ */
+void UMassGravityTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	BuildContext.RequireFragment<FTransformFragment>();
+	BuildContext.AddFragment<FMassGravityFragment>();
+}
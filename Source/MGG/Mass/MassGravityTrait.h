@@ -0,0 +1,22 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "MassGravityTrait.generated.h"
+
+/**
+ * @brief Makes the entities of a Mass entity config affected by the gravity fields.
+ *
+ * @details Adds the gravity fragment (and requires the transform fragment it reads the
+ * position from), so UMassGravityProcessor picks the entities up.
+ */
+UCLASS(meta = (DisplayName = "Gravity"))
+class MGG_API UMassGravityTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+protected:
+	//////// METHODS ////////
+	//// UMassEntityTraitBase implementation
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
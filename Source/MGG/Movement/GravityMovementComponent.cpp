@@ -0,0 +1,398 @@
+﻿#include "GravityMovementComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "MGG/Utils/Interfaces/GravityAffected.h"
+#include "MGG/GravityFields/BaseGravityFieldComponent.h"
+#include "MGG/Utils/Subsystems/GravityProbeSubsystem.h"
+#include "MGG/Utils/Subsystems/GravityWorldSubsystem.h"
+
+/**
+ * @brief Constructor for the gravity movement component.
+ *
+ * @details Movement ticks in TG_PrePhysics, after the gravity update pass (see BeginPlay).
+ */
+UGravityMovementComponent::UGravityMovementComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+/**
+ * @brief Called when the game starts or when the owner is spawned.
+ *
+ * @details Caches the owner's gravity interface and the ground probe subsystem, and makes the
+ * movement tick wait for the gravity subsystem's update pass, so every move uses the gravity
+ * computed for the current frame.
+ */
+void UGravityMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	GravityAffected = Cast<IGravityAffected>(GetOwner());
+	ProbeSubsystem = UGravityProbeSubsystem::Get(this);
+
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->AddGravityUpdateDependent(PrimaryComponentTick);
+	}
+}
+
+/**
+ * @brief Called when the component is removed from play.
+ *
+ * @param EndPlayReason The reason play ended.
+ */
+void UGravityMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->RemoveGravityUpdateDependent(PrimaryComponentTick);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Moves the updated component for this frame.
+ *
+ * @details The frame is processed as follows:
+ * 1. Reads the owner's gravity vector; its opposite is the pawn's up direction
+ * 2. Consumes the movement input as a velocity tangent to the gravity
+ * 3. If a fixed step runs this frame, puts the updated component back on the current simulated
+ *    state and picks up the last delivered ground probe
+ * 4. Adds the frame time to the accumulator and runs as many fixed steps as it holds, up to
+ *    MaxStepsPerFrame; the time beyond that is dropped. Grounded pawns check their ground after
+ *    every step, even one that did not move them, since the ground itself may have moved away
+ * 5. Presents the updated component between the previous and current simulated states
+ * 6. Requests a ground probe from the current simulated state if a step needed one
+ *
+ * Steps 3 to 5 run in a deferred movement scope, so children and overlaps of the updated
+ * component are only updated once, with the presented location, however many moves were made.
+ *
+ * @param DeltaTime The frame delta time.
+ * @param TickType The kind of tick being performed.
+ * @param ThisTickFunction The tick function running this component.
+ */
+void UGravityMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	if (ShouldSkipUpdate(DeltaTime))
+	{
+		return;
+	}
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!PawnOwner || !UpdatedComponent || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	const FVector Gravity = GravityAffected ? GravityAffected->GetGravityVector() : FVector::ZeroVector;
+	const FVector Up = Gravity.IsNearlyZero() ? UpdatedComponent->GetUpVector() : -Gravity.GetUnsafeNormal();
+
+	const FVector InputVector = ConsumeInputVector().GetClampedToMaxSize(1.0f);
+	const FVector TangentVelocity = FVector::VectorPlaneProject(InputVector, Up) * MoveSpeed;
+
+	const float FixedTimeStep = 1.0f / SimulationRate;
+
+	{
+		FScopedMovementUpdate ScopedMovementUpdate(UpdatedComponent, EScopedUpdate::DeferredUpdates);
+
+		RestoreSimulatedState(TimeAccumulator + DeltaTime >= FixedTimeStep);
+
+		// The probe subsystem keeps a delivered result until a frame running a step takes it
+		if (TimeAccumulator + DeltaTime >= FixedTimeStep)
+		{
+			bHasProbedGround = ProbeSubsystem && ProbeSubsystem->ConsumeGroundProbe(UpdatedPrimitive, ProbedGround);
+		}
+
+		TimeAccumulator += DeltaTime;
+
+		for (int32 Step = 0; Step < MaxStepsPerFrame && TimeAccumulator >= FixedTimeStep; ++Step)
+		{
+			PreviousSimulatedLocation = CurrentSimulatedLocation;
+
+			PerformStep(Gravity, Up, TangentVelocity, FixedTimeStep);
+
+			if (bIsGrounded)
+			{
+				SnapToGround(Up);
+			}
+
+			CurrentSimulatedLocation = UpdatedComponent->GetComponentLocation();
+			TimeAccumulator -= FixedTimeStep;
+		}
+
+		if (TimeAccumulator >= FixedTimeStep)
+		{
+			TimeAccumulator = FMath::Fmod(TimeAccumulator, FixedTimeStep);
+		}
+
+		PresentSimulatedState(TimeAccumulator / FixedTimeStep);
+	}
+
+	UpdateComponentVelocity();
+
+	if (bNeedsGroundProbe)
+	{
+		ProbeSubsystem->RequestGroundProbe(UpdatedPrimitive, CurrentSimulatedLocation, CurrentSimulatedLocation - Up * GroundSnapDistance);
+		bNeedsGroundProbe = false;
+	}
+}
+
+/**
+ * @brief Performs one fixed step of the movement.
+ *
+ * @details Grounded pawns walk along the ground at full speed, whatever its slope. Airborne pawns
+ * keep their velocity along the gravity and integrate the gravity into it, clamped to MaxFallSpeed.
+ * The move is then swept; on a blocking hit, the velocity going into the surface is removed so it
+ * does not build up against it, and the remaining move slides along the surface. Hitting a
+ * walkable surface lands the pawn.
+ *
+ * @param Gravity The gravity vector affecting the pawn.
+ * @param Up The pawn's up direction, opposite to the gravity.
+ * @param TangentVelocity The velocity requested by the movement input, tangent to the gravity.
+ * @param StepTime The duration of the step.
+ */
+void UGravityMovementComponent::PerformStep(const FVector& Gravity, const FVector& Up, const FVector& TangentVelocity, float StepTime)
+{
+	if (bIsGrounded)
+	{
+		Velocity = FVector::VectorPlaneProject(TangentVelocity, GroundNormal).GetSafeNormal() * TangentVelocity.Size();
+	}
+	else
+	{
+		Velocity = TangentVelocity + Up * FVector::DotProduct(Velocity, Up) + Gravity * StepTime;
+
+		const float FallSpeed = -FVector::DotProduct(Velocity, Up);
+		if (FallSpeed > MaxFallSpeed)
+		{
+			Velocity += Up * (FallSpeed - MaxFallSpeed);
+		}
+	}
+
+	const FVector Delta = Velocity * StepTime;
+	if (Delta.IsNearlyZero())
+	{
+		return;
+	}
+
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if (Hit.IsValidBlockingHit())
+	{
+		HandleImpact(Hit, StepTime, Delta);
+
+		if (IsWalkable(Hit, Up))
+		{
+			bIsGrounded = true;
+			GroundNormal = Hit.ImpactNormal;
+		}
+
+		const float IntoSurfaceSpeed = FVector::DotProduct(Velocity, Hit.Normal);
+		if (IntoSurfaceSpeed < 0.0f)
+		{
+			Velocity -= Hit.Normal * IntoSurfaceSpeed;
+		}
+
+		SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+	}
+}
+
+/**
+ * @brief Keeps a grounded pawn on the surface.
+ *
+ * @details Tries the analytic planet surface of the active gravity field first. Otherwise, the pawn
+ * stands on something the field does not describe: the ground is found by sweeping the updated
+ * component along the gravity up to GroundSnapDistance, asynchronously through the ground probe
+ * subsystem when it is enabled (see SnapToProbedGround), synchronously otherwise. If a walkable
+ * surface is found, the pawn is moved onto it; otherwise it walked off an edge and starts falling.
+ *
+ * @param Up The pawn's up direction, opposite to the gravity.
+ */
+void UGravityMovementComponent::SnapToGround(const FVector& Up)
+{
+	if (!UpdatedPrimitive)
+	{
+		bIsGrounded = false;
+		return;
+	}
+
+	if (SnapToPlanetSurface(Up))
+	{
+		return;
+	}
+
+	if (ProbeSubsystem && UGravityProbeSubsystem::IsAsyncProbingEnabled())
+	{
+		SnapToProbedGround(Up);
+		return;
+	}
+
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	const FVector End = Start - Up * GroundSnapDistance;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GravityGroundSnap), false, PawnOwner);
+	FCollisionResponseParams ResponseParams;
+	UpdatedPrimitive->InitSweepCollisionParams(QueryParams, ResponseParams);
+
+	FHitResult Hit;
+	const bool bHit = GetWorld()->SweepSingleByChannel(Hit, Start, End, UpdatedComponent->GetComponentQuat(), UpdatedPrimitive->GetCollisionObjectType(), UpdatedPrimitive->GetCollisionShape(), QueryParams, ResponseParams);
+
+	if (bHit && !Hit.bStartPenetrating && IsWalkable(Hit, Up))
+	{
+		GroundNormal = Hit.ImpactNormal;
+		MoveUpdatedComponent(Hit.Location - Start, UpdatedComponent->GetComponentQuat(), false);
+	}
+	else
+	{
+		bIsGrounded = false;
+	}
+}
+
+/**
+ * @brief Snaps a grounded pawn onto the planet surface of its active gravity field.
+ *
+ * @details The gap between the pawn and the surface is the signed distance from the pawn's center
+ * to the surface minus the pawn's collision extent along its up axis. Within GroundSnapDistance
+ * (either way, since planet meshes are only close to their analytic shape) and on a walkable slope,
+ * the pawn is grounded on the planet: it is moved down onto it if needed, and the surface normal
+ * becomes the ground normal.
+ *
+ * @param Up The pawn's up direction, opposite to the gravity.
+ * @return True if the pawn is grounded on the planet surface, false if the sweep is needed.
+ */
+bool UGravityMovementComponent::SnapToPlanetSurface(const FVector& Up)
+{
+	UBaseGravityFieldComponent* ActiveField = GravityAffected ? GravityAffected->GetActiveGravityField() : nullptr;
+
+	float SignedDistance;
+	FVector SurfaceNormal;
+	if (!ActiveField || !ActiveField->CalculateSurfaceContact(UpdatedComponent->GetComponentLocation(), SignedDistance, SurfaceNormal))
+	{
+		return false;
+	}
+
+	const float Gap = SignedDistance - UpdatedPrimitive->GetCollisionShape().GetExtent().Z;
+	if (FMath::Abs(Gap) > GroundSnapDistance || FVector::DotProduct(SurfaceNormal, Up) < FMath::Cos(FMath::DegreesToRadians(MaxWalkableAngle)))
+	{
+		return false;
+	}
+
+	GroundNormal = SurfaceNormal;
+
+	if (Gap > UE_KINDA_SMALL_NUMBER)
+	{
+		MoveUpdatedComponent(-SurfaceNormal * Gap, UpdatedComponent->GetComponentQuat(), false);
+	}
+	return true;
+}
+
+/**
+ * @brief Snaps a grounded pawn onto the ground found by last frame's probe.
+ *
+ * @details Asks for a new probe at the end of this frame. Until a result is delivered, the pawn
+ * stays grounded where it is. A delivered result is applied once: the pawn drops by the distance
+ * the probe swept before hitting walkable ground, or starts falling if the probe found none.
+ * The probe was swept from last frame's location, so the drop is swept again from the current
+ * one and stops on whatever the pawn has reached since.
+ *
+ * @param Up The pawn's up direction, opposite to the gravity.
+ */
+void UGravityMovementComponent::SnapToProbedGround(const FVector& Up)
+{
+	bNeedsGroundProbe = true;
+
+	if (!bHasProbedGround)
+	{
+		return;
+	}
+
+	bHasProbedGround = false;
+
+	if (ProbedGround.bBlockingHit && !ProbedGround.bStartPenetrating && IsWalkable(ProbedGround, Up))
+	{
+		GroundNormal = ProbedGround.ImpactNormal;
+
+		FHitResult Hit;
+		MoveUpdatedComponent(-Up * ProbedGround.Distance, UpdatedComponent->GetComponentQuat(), true, &Hit);
+
+		if (Hit.IsValidBlockingHit() && IsWalkable(Hit, Up))
+		{
+			GroundNormal = Hit.ImpactNormal;
+		}
+	}
+	else
+	{
+		bIsGrounded = false;
+	}
+}
+
+/**
+ * @brief Puts the updated component back on the current simulated state before simulating.
+ *
+ * @details If the updated component is no longer where this component presented it, something
+ * else moved it (e.g. a teleport): the simulated state restarts from its new location. On frames
+ * running no fixed step, the component is left where it was presented, and the presentation moves
+ * it straight from there.
+ *
+ * @param bWillSimulate Whether a fixed step runs this frame.
+ */
+void UGravityMovementComponent::RestoreSimulatedState(bool bWillSimulate)
+{
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+
+	if (!bHasSimulatedState || !Location.Equals(PresentedLocation))
+	{
+		PreviousSimulatedLocation = Location;
+		CurrentSimulatedLocation = Location;
+		TimeAccumulator = 0.0f;
+		bHasSimulatedState = true;
+	}
+	else if (bWillSimulate && !Location.Equals(CurrentSimulatedLocation))
+	{
+		MoveUpdatedComponent(CurrentSimulatedLocation - Location, UpdatedComponent->GetComponentQuat(), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+}
+
+/**
+ * @brief Presents the updated component between the previous and current simulated states.
+ *
+ * @param Alpha The fraction of a fixed step left in the accumulator.
+ */
+void UGravityMovementComponent::PresentSimulatedState(float Alpha)
+{
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FVector Target = bInterpolateMovement ? FMath::Lerp(PreviousSimulatedLocation, CurrentSimulatedLocation, Alpha) : CurrentSimulatedLocation;
+
+	if (!Location.Equals(Target))
+	{
+		MoveUpdatedComponent(Target - Location, UpdatedComponent->GetComponentQuat(), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	PresentedLocation = UpdatedComponent->GetComponentLocation();
+}
+
+/**
+ * @brief Checks whether the pawn can stand on a hit surface.
+ *
+ * @param Hit The hit to check.
+ * @param Up The pawn's up direction, opposite to the gravity.
+ * @return True if the surface is no steeper than MaxWalkableAngle relative to the gravity.
+ */
+bool UGravityMovementComponent::IsWalkable(const FHitResult& Hit, const FVector& Up) const
+{
+	return FVector::DotProduct(Hit.ImpactNormal, Up) >= FMath::Cos(FMath::DegreesToRadians(MaxWalkableAngle));
+}
+
+/**
+ * @brief Gets the maximum speed of the pawn.
+ *
+ * @return The walking speed.
+ */
+float UGravityMovementComponent::GetMaxSpeed() const
+{
+	return MoveSpeed;
+}
@@ -0,0 +1,115 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "GravityMovementComponent.generated.h"
+
+//////// FORWARD DECLARATION ////////
+//// Class
+class IGravityAffected;
+class UGravityProbeSubsystem;
+
+/**
+ * @brief Movement component for pawns walking on gravity fields.
+ *
+ * @details Reads the gravity vector of its owner (which must implement IGravityAffected, and is
+ * updated by the gravity subsystem before this component ticks) and moves the updated component with it:
+ * - Movement input sets the velocity tangent to the gravity, or to the ground while grounded
+ * - The velocity along the gravity persists across frames and integrates the gravity while airborne
+ * - The movement is simulated at a fixed rate (SimulationRate) from a time accumulator, each
+ *   step being a swept move that slides along whatever it hits, so fast falls and frame hitches
+ *   cannot tunnel through a planet, and a simulated second costs the same at any frame rate
+ * - Grounded pawns are snapped back onto the surface after each step, so walking around a curved
+ *   planet does not lift them off it. The planet surface of the active gravity field is known
+ *   analytically, so snapping onto it costs no physics query; the sweep is only a fallback for
+ *   what the field does not describe, like props standing on the planet. That sweep goes through
+ *   the ground probe subsystem: it is batched with every other probe of the frame, runs
+ *   asynchronously, and its result is applied the next frame
+ *
+ * The component keeps the previous and current simulated locations, and presents the updated
+ * component between them according to the time left in the accumulator. The presented location is
+ * always on the segment of a swept step, and the component is put back on the simulated state
+ * before simulating again. Frames running no step only move it once, to its new presented location.
+ */
+UCLASS(ClassGroup = (Movement), meta = (BlueprintSpawnableComponent))
+class MGG_API UGravityMovementComponent : public UPawnMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	//////// CONSTRUCTOR ////////
+	UGravityMovementComponent();
+
+	//////// UNREAL LIFECYCLE ////////
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	//////// METHODS ////////
+	//// UMovementComponent implementation
+	virtual float GetMaxSpeed() const override;
+
+	//////// INLINE METHODS ////////
+	//// Getters accessors
+	FORCEINLINE bool IsGrounded() const { return bIsGrounded; }
+	FORCEINLINE const FVector& GetGroundNormal() const { return GroundNormal; }
+
+	//////// FIELDS ////////
+	//// Movement fields
+	UPROPERTY(EditAnywhere, Category = "Gravity Movement", meta = (ClampMin = "0.0", Units = "CentimetersPerSecond"))
+	float MoveSpeed = 500.0f;
+	UPROPERTY(EditAnywhere, Category = "Gravity Movement", meta = (ClampMin = "0.0", Units = "CentimetersPerSecond"))
+	float MaxFallSpeed = 4000.0f;
+	UPROPERTY(EditAnywhere, Category = "Gravity Movement", meta = (ClampMin = "0.0", ClampMax = "90.0", Units = "Degrees"))
+	float MaxWalkableAngle = 50.0f; // Steepest surface, relative to the gravity, the pawn can stand on
+	UPROPERTY(EditAnywhere, Category = "Gravity Movement", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float GroundSnapDistance = 20.0f;
+
+	//// Fixed timestep fields
+	UPROPERTY(EditAnywhere, Category = "Gravity Movement|Fixed Timestep", meta = (ClampMin = "1.0", Units = "Hertz"))
+	float SimulationRate = 120.0f;
+	UPROPERTY(EditAnywhere, Category = "Gravity Movement|Fixed Timestep", meta = (ClampMin = "1"))
+	int32 MaxStepsPerFrame = 8; // Simulation time beyond this is dropped, so a long hitch slows the pawn down instead of stalling the frame
+	UPROPERTY(EditAnywhere, Category = "Gravity Movement|Fixed Timestep")
+	bool bInterpolateMovement = true;
+
+protected:
+	//////// UNREAL LIFECYCLE ////////
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	//////// METHODS ////////
+	//// Movement methods
+	void PerformStep(const FVector& Gravity, const FVector& Up, const FVector& TangentVelocity, float StepTime);
+	void SnapToGround(const FVector& Up);
+	bool SnapToPlanetSurface(const FVector& Up);
+	void SnapToProbedGround(const FVector& Up);
+
+	//// Fixed timestep methods
+	void RestoreSimulatedState(bool bWillSimulate);
+	void PresentSimulatedState(float Alpha);
+
+	//// Check methods
+	bool IsWalkable(const FHitResult& Hit, const FVector& Up) const;
+
+private:
+	//////// FIELDS ////////
+	//// Gravity fields
+	IGravityAffected* GravityAffected = nullptr;
+
+	//// Ground probe fields
+	UPROPERTY(Transient)
+	UGravityProbeSubsystem* ProbeSubsystem = nullptr;
+	FHitResult ProbedGround;
+	bool bHasProbedGround = false;
+	bool bNeedsGroundProbe = false;
+
+	//// State fields
+	bool bIsGrounded = false;
+	FVector GroundNormal = FVector::UpVector;
+
+	//// Fixed timestep fields
+	float TimeAccumulator = 0.0f;
+	bool bHasSimulatedState = false;
+	FVector PreviousSimulatedLocation = FVector::ZeroVector;
+	FVector CurrentSimulatedLocation = FVector::ZeroVector;
+	FVector PresentedLocation = FVector::ZeroVector; // Where this component last left the updated component
+};
@@ -0,0 +1,103 @@
+﻿#include "GravityOrientationComponent.h"
+#include "GameFramework/Actor.h"
+#include "MGG/Utils/Interfaces/GravityAffected.h"
+#include "MGG/Utils/Subsystems/GravityWorldSubsystem.h"
+
+/**
+ * @brief Constructor for the gravity orientation component.
+ *
+ * @details Orientation ticks in TG_PrePhysics, after the gravity update pass (see BeginPlay).
+ */
+UGravityOrientationComponent::UGravityOrientationComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+/**
+ * @brief Called when the game starts or when the owner is spawned.
+ *
+ * @details Caches the owner's gravity interface, takes the owner's current up direction as the
+ * first target, and makes the orientation tick wait for the gravity subsystem's update pass.
+ */
+void UGravityOrientationComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	GravityAffected = Cast<IGravityAffected>(GetOwner());
+
+	if (AActor* Owner = GetOwner())
+	{
+		TargetRotation = Owner->GetActorQuat();
+		TargetUp = TargetRotation.GetUpVector();
+	}
+
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->AddGravityUpdateDependent(PrimaryComponentTick);
+	}
+}
+
+/**
+ * @brief Called when the component is removed from play.
+ *
+ * @param EndPlayReason The reason play ended.
+ */
+void UGravityOrientationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->RemoveGravityUpdateDependent(PrimaryComponentTick);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Follows the owner's gravity for this frame.
+ *
+ * @details The frame is processed as follows:
+ * 1. Compares the up direction opposite to the gravity with the last target's up direction
+ * 2. Past AngleThreshold, restarts a blend from the owner's current rotation to the smallest
+ *    rotation putting its up axis on the new up direction
+ * 3. While a blend is running, advances it by DeltaTime / BlendTime and applies the slerped
+ *    rotation; otherwise the owner's transform is not touched
+ *
+ * @param DeltaTime The frame delta time.
+ * @param TickType The kind of tick being performed.
+ * @param ThisTickFunction The tick function running this component.
+ */
+void UGravityOrientationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	AActor* Owner = GetOwner();
+	if (!Owner || !GravityAffected)
+	{
+		return;
+	}
+
+	const FVector& Gravity = GravityAffected->GetGravityVector();
+	if (Gravity.IsNearlyZero())
+	{
+		return;
+	}
+
+	const FVector NewUp = -Gravity.GetUnsafeNormal();
+
+	if (FVector::DotProduct(NewUp, TargetUp) < FMath::Cos(FMath::DegreesToRadians(AngleThreshold)))
+	{
+		StartRotation = Owner->GetActorQuat();
+		TargetRotation = FQuat::FindBetweenNormals(StartRotation.GetUpVector(), NewUp) * StartRotation;
+		TargetUp = NewUp;
+		BlendAlpha = 0.0f;
+	}
+
+	if (BlendAlpha >= 1.0f)
+	{
+		return;
+	}
+
+	BlendAlpha = BlendTime > 0.0f ? FMath::Min(BlendAlpha + DeltaTime / BlendTime, 1.0f) : 1.0f;
+	Owner->SetActorRotation(FQuat::Slerp(StartRotation, TargetRotation, BlendAlpha));
+}
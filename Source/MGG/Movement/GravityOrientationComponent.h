@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GravityOrientationComponent.generated.h"
+
+//////// FORWARD DECLARATION ////////
+//// Class
+class IGravityAffected;
+
+/**
+ * @brief Keeps its owner standing upright against the gravity.
+ *
+ * @details Reads the gravity vector of its owner (which must implement IGravityAffected) after the
+ * gravity subsystem's update pass. While the up direction stays within AngleThreshold of the last
+ * target, nothing is written: a pawn resting on a planet costs one dot product per frame and no
+ * transform update. Once the up direction moves past the threshold, a new target rotation is
+ * taken with the smallest turn from the current one (so the owner keeps its heading) and the owner
+ * is slerped to it over BlendTime, then left alone again.
+ */
+UCLASS(ClassGroup = (Movement), meta = (BlueprintSpawnableComponent))
+class MGG_API UGravityOrientationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	//////// CONSTRUCTOR ////////
+	UGravityOrientationComponent();
+
+	//////// UNREAL LIFECYCLE ////////
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	//////// FIELDS ////////
+	//// Orientation fields
+	UPROPERTY(EditAnywhere, Category = "Gravity Orientation", meta = (ClampMin = "0.0", ClampMax = "90.0", Units = "Degrees"))
+	float AngleThreshold = 1.0f;
+	UPROPERTY(EditAnywhere, Category = "Gravity Orientation", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float BlendTime = 0.15f; // 0 snaps to the target at once
+
+protected:
+	//////// UNREAL LIFECYCLE ////////
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	//////// FIELDS ////////
+	//// Gravity fields
+	IGravityAffected* GravityAffected = nullptr;
+
+	//// Blend fields
+	FVector TargetUp = FVector::UpVector;
+	FQuat StartRotation = FQuat::Identity;
+	FQuat TargetRotation = FQuat::Identity;
+	float BlendAlpha = 1.0f; // 1 once the target is reached
+};
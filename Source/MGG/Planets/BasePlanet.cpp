@@ -1,6 +1,7 @@
 ﻿#include "BasePlanet.h"
 
 #include "MGG/GravityFields/BaseGravityFieldComponent.h"
+#include "MGG/Utils/Subsystems/PlanetMotionSubsystem.h"
 
 /**
  * @brief Constructor for the base planet class.
@@ -10,7 +11,7 @@
  */
 ABasePlanet::ABasePlanet()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	PlanetMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("PlanetMesh"));
 	PlanetMesh->SetGenerateOverlapEvents(false);
@@ -30,7 +31,9 @@ ABasePlanet::ABasePlanet()
 /**
  * @brief Called when the game starts or when the actor is spawned.
  *
- * @details Caches the gravity field component and initializes its dimensions and debug visualization.
+ * @details Caches the gravity field component and queues the update of its dimensions and debug visualization.
+ * Planets with motion settings are handed to the planet motion subsystem, which moves them
+ * instead of a per-planet tick. Their mobility is already set in OnConstruction.
  */
 void ABasePlanet::BeginPlay()
 {
@@ -38,11 +41,35 @@ void ABasePlanet::BeginPlay()
 	
 	if (CachedGravityField)
 	{
-		CachedGravityField->UpdateGravityVolume();
-		CachedGravityField->RedrawDebugField();
+		CachedGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 	
 	Super::BeginPlay();
+
+	if (MotionSettings.IsMoving())
+	{
+		if (UPlanetMotionSubsystem* MotionSubsystem = UPlanetMotionSubsystem::Get(this))
+		{
+			MotionSubsystem->RegisterPlanet(this, MotionSettings);
+		}
+	}
+}
+
+/**
+ * @brief Called when the planet is removed from the world.
+ *
+ * @details Stops the planet's motion if it was registered with the planet motion subsystem.
+ *
+ * @param EndPlayReason The reason the planet is leaving play.
+ */
+void ABasePlanet::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPlanetMotionSubsystem* MotionSubsystem = UPlanetMotionSubsystem::Get(this))
+	{
+		MotionSubsystem->UnregisterPlanet(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 /**
@@ -76,21 +103,31 @@ void ABasePlanet::UpdatePlanetMesh()
 }
 
 /**
- * @brief Called every frame to update the planet.
- *
- * @details Handles any per-frame updates required by the planet.
+ * @brief Sets up the planet's mobility from its motion settings.
  *
- * @param DeltaTime The time elapsed since the last frame.
+ * @details Moving planets get a movable mesh and a kinematic gravity field. This is decided
+ * at construction, so the mesh is never registered as static and then switched to movable
+ * once play begins, which would recreate its render and physics state.
  */
-void ABasePlanet::Tick(float DeltaTime)
+void ABasePlanet::UpdatePlanetMobility()
 {
-	Super::Tick(DeltaTime);
+	const bool bIsMoving = MotionSettings.IsMoving();
+
+	if (PlanetMesh && bIsMoving)
+	{
+		PlanetMesh->SetMobility(EComponentMobility::Movable);
+	}
+
+	if (UBaseGravityFieldComponent* GravityField = GetComponentByClass<UBaseGravityFieldComponent>())
+	{
+		GravityField->bKinematicMotion = bIsMoving;
+	}
 }
 
 /**
  * @brief Called when the actor is placed or moved in the editor.
  *
- * @details Updates the planet's mesh and scale to ensure proper visualization in the editor.
+ * @details Updates the planet's mesh, scale and mobility to ensure proper visualization in the editor.
  *
  * @param Transform The new transform of the actor.
  */
@@ -100,6 +137,7 @@ void ABasePlanet::OnConstruction(const FTransform& Transform)
 
 	UpdatePlanetMesh();
 	UpdatePlanetScale();
+	UpdatePlanetMobility();
 }
 
 /**
@@ -131,9 +169,9 @@ void ABasePlanet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedE
 		SyncGravityFieldSettings();
 	}
 	
-	if (UBaseGravityFieldComponent* GravityField = GetComponentByClass<UBaseGravityFieldComponent>()) //work but not optimized -> disable it after level design
+	if (UBaseGravityFieldComponent* GravityField = GetComponentByClass<UBaseGravityFieldComponent>())
 	{
-		GravityField->RedrawDebugField();
+		GravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Debug);
 	}
 }
 
@@ -150,7 +188,7 @@ void ABasePlanet::PostEditMove(bool bFinished)
 
 	if (UBaseGravityFieldComponent* GravityField = GetComponentByClass<UBaseGravityFieldComponent>())
 	{
-		GravityField->RedrawDebugField();
+		GravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Debug);
 	}
 }
 
@@ -166,6 +204,9 @@ void ABasePlanet::PostEditMove(bool bFinished)
  * 2. Compares current settings with the component's settings
  * 3. Updates only the values that have changed
  * 
+ * Each setter bumps the field's version and queues the field in the gravity subsystem's
+ * dirty list, so caches and indices depending on it are rebuilt at the next flush.
+ * 
  * This is essential for maintaining consistency between the planet's visual representation
  * and its gravitational effects on gameplay.
  */
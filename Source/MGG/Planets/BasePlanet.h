@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "MGG/Planets/PlanetMotionSettings.h"
 #include "BasePlanet.generated.h"
 
 //////// FORWARD DECLARATION ////////
@@ -20,7 +21,6 @@ public:
 	ABasePlanet();
 
 	//////// UNREAL LIFECYCLE ////////
-	virtual void Tick(float DeltaTime) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 	virtual void PostEditMove(bool bFinished) override;
@@ -37,15 +37,21 @@ public:
 	int32 GravityFieldPriority;
 	UPROPERTY(EditAnywhere, Category = "Planet Settings|Gravity", meta = (DisplayName = "Influence Range"))
 	float GravityInfluenceRange;
+
+	//// Motion configuration
+	UPROPERTY(EditAnywhere, Category = "Planet Settings|Motion", meta = (DisplayName = "Motion"))
+	FPlanetMotionSettings MotionSettings;
 	
 protected:
 	//////// UNREAL LIFECYCLE ////////
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	//////// METHODS ////////
 	//// Planet methods
 	virtual void UpdatePlanetScale();
 	void UpdatePlanetMesh();
+	void UpdatePlanetMobility();
 
 	//// Gravity methods
 	virtual void SyncGravityFieldSettings();
@@ -8,7 +8,7 @@
  */
 ACubicPlanet::ACubicPlanet()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	CubeGravityField = CreateDefaultSubobject<UCubeGravityFieldComponent>(TEXT("CubeGravityField"));
 	CubeGravityField->SetupAttachment(RootComponent);
@@ -28,8 +28,7 @@ void ACubicPlanet::BeginPlay()
 
 	if (CubeGravityField)
 	{
-		CubeGravityField->UpdateFieldDimensions();
-		CubeGravityField->RedrawDebugField();
+		CubeGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
 
@@ -49,7 +48,6 @@ void ACubicPlanet::OnConstruction(const FTransform& Transform)
 
 	if (CubeGravityField)
 	{
-		CubeGravityField->UpdateFieldDimensions();
-		CubeGravityField->RedrawDebugField();
+		CubeGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
@@ -9,7 +9,7 @@
  */
 ACylinderPlanet::ACylinderPlanet()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMeshAsset(TEXT("/Engine/BasicShapes/Cylinder"));
 	if (CylinderMeshAsset.Succeeded() && PlanetMesh)
@@ -39,8 +39,7 @@ void ACylinderPlanet::BeginPlay()
 		float cylinderHeight = PlanetRadius * CylinderHeightRatio;
 		CylinderGravityField->CylinderHeight = cylinderHeight;
         
-		CylinderGravityField->UpdateFieldDimensions();
-		CylinderGravityField->RedrawDebugField();
+		CylinderGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
 
@@ -63,7 +62,6 @@ void ACylinderPlanet::OnConstruction(const FTransform& Transform)
 		float cylinderHeight = PlanetRadius * CylinderHeightRatio;
 		CylinderGravityField->CylinderHeight = cylinderHeight;
         
-		CylinderGravityField->UpdateFieldDimensions();
-		CylinderGravityField->RedrawDebugField();
+		CylinderGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
@@ -8,7 +8,7 @@
  */
 APlanePlanet::APlanePlanet()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	PlaneGravityField = CreateDefaultSubobject<UPlaneGravityFieldComponent>(TEXT("PlaneGravityField"));
 	PlaneGravityField->SetupAttachment(RootComponent);
@@ -28,8 +28,7 @@ void APlanePlanet::BeginPlay()
 
 	if (PlaneGravityField)
 	{
-		PlaneGravityField->UpdateFieldDimensions();
-		PlaneGravityField->RedrawDebugField();
+		PlaneGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
 
@@ -60,7 +59,6 @@ void APlanePlanet::OnConstruction(const FTransform& Transform)
 
 	if (PlaneGravityField)
 	{
-		PlaneGravityField->UpdateFieldDimensions();
-		PlaneGravityField->RedrawDebugField();
+		PlaneGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
\ No newline at end of file
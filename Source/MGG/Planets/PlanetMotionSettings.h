@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "PlanetMotionSettings.generated.h"
+
+/**
+ * @brief Compact description of a planet's motion, advanced by the planet motion subsystem.
+ *
+ * @details A planet orbits around OrbitCenter, in the plane perpendicular to OrbitAxis, starting
+ * from where it was placed, and spins around its own SpinAxis. Both motions are optional: a zero
+ * speed disables the matching motion.
+ */
+USTRUCT(BlueprintType)
+struct MGG_API FPlanetMotionSettings
+{
+	GENERATED_BODY()
+
+	//////// FIELDS ////////
+	//// Orbit fields
+	UPROPERTY(EditAnywhere, Category = "Orbit")
+	FVector OrbitCenter = FVector::ZeroVector;
+	UPROPERTY(EditAnywhere, Category = "Orbit")
+	FVector OrbitAxis = FVector::UpVector;
+	UPROPERTY(EditAnywhere, Category = "Orbit", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float OrbitRadius = 0.0f; // 0 keeps the planet's placed distance to the orbit center
+	UPROPERTY(EditAnywhere, Category = "Orbit", meta = (Units = "DegreesPerSecond"))
+	float OrbitAngularSpeed = 0.0f;
+
+	//// Spin fields
+	UPROPERTY(EditAnywhere, Category = "Spin")
+	FVector SpinAxis = FVector::UpVector; // In the planet's local space
+	UPROPERTY(EditAnywhere, Category = "Spin", meta = (Units = "DegreesPerSecond"))
+	float SpinAngularSpeed = 0.0f;
+
+	//////// INLINE METHODS ////////
+	//// Check methods
+	FORCEINLINE bool IsMoving() const { return OrbitAngularSpeed != 0.0f || SpinAngularSpeed != 0.0f; }
+};
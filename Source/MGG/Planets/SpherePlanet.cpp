@@ -8,7 +8,7 @@
  */
 ASpherePlanet::ASpherePlanet()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	SphereGravityField = CreateDefaultSubobject<USphereGravityFieldComponent>(TEXT("SphereGravityField"));
 	SphereGravityField->SetupAttachment(RootComponent);
@@ -28,8 +28,7 @@ void ASpherePlanet::BeginPlay()
 
 	if (SphereGravityField)
 	{
-		SphereGravityField->UpdateFieldDimensions();
-		SphereGravityField->RedrawDebugField();
+		SphereGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
 
@@ -49,7 +48,6 @@ void ASpherePlanet::OnConstruction(const FTransform& Transform)
 
 	if (SphereGravityField)
 	{
-		SphereGravityField->UpdateFieldDimensions();
-		SphereGravityField->RedrawDebugField();
+		SphereGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
@@ -9,7 +9,7 @@
  */
 ATorusPlanet::ATorusPlanet()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	TorusMesh = CreateDefaultSubobject<UTorusMeshComponent>(TEXT("TorusMesh"));
 	TorusMesh->SetupAttachment(RootComponent);
@@ -41,8 +41,7 @@ void ATorusPlanet::BeginPlay()
     
 	if (TorusGravityField)
 	{
-		TorusGravityField->UpdateFieldDimensions();
-		TorusGravityField->RedrawDebugField();
+		TorusGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
 
@@ -90,8 +89,7 @@ void ATorusPlanet::OnConstruction(const FTransform& Transform)
     
 	if (TorusGravityField)
 	{
-		TorusGravityField->UpdateFieldDimensions();
-		TorusGravityField->RedrawDebugField();
+		TorusGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 	}
 }
 
@@ -119,8 +117,7 @@ void ATorusPlanet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChanged
 		
 		if (TorusGravityField)
 		{
-			TorusGravityField->UpdateFieldDimensions();
-			TorusGravityField->RedrawDebugField();
+			TorusGravityField->MarkGravityFieldDirty(EGravityFieldDirtyFlags::Dimensions);
 		}
 	}
 }
@@ -272,3 +272,29 @@ void GravityFieldDrawer::DrawPlane(const FVector& Center, const FVector& Normal,
     // Norml arrow
     DrawLine(VolumeBase, VolumeBase + Normal * (Size * 0.2f), FColor::Red);
 }
+
+/**
+ * @brief Moves every line already drawn along with a rigid transform change.
+ *
+ * @details Lines are stored in world space, so a field that only moved or rotated can carry its
+ * existing drawing along instead of flushing and regenerating every shape: each line end is
+ * brought back to the old local space and out again with the new transform.
+ *
+ * @param FromTransform The transform the lines were drawn with.
+ * @param ToTransform The transform the lines must follow.
+ */
+void GravityFieldDrawer::TransformLines(const FTransform& FromTransform, const FTransform& ToTransform)
+{
+	if (!DebugLines || DebugLines->BatchedLines.Num() == 0)
+	{
+		return;
+	}
+
+	for (FBatchedLine& Line : DebugLines->BatchedLines)
+	{
+		Line.Start = ToTransform.TransformPosition(FromTransform.InverseTransformPosition(Line.Start));
+		Line.End = ToTransform.TransformPosition(FromTransform.InverseTransformPosition(Line.End));
+	}
+
+	DebugLines->MarkRenderStateDirty();
+}
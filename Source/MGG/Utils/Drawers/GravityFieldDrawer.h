@@ -16,6 +16,9 @@ public:
 	void DrawTorus(const FVector& Center, float TorusRadius, float TubeRadius, int32 Segments, const FColor& Color);
 	void DrawPlane(const FVector& Center, const FVector& Normal, const FRotator& Rotation, float Size, float Height, const FColor& Color);
 
+	//// Transform methods
+	void TransformLines(const FTransform& FromTransform, const FTransform& ToTransform);
+
 private:
 	//////// INLINE METHODS ////////
 	//// Helper methods
@@ -1,12 +1,140 @@
 ﻿#include "GravityAffected.h"
 #include "MGG/GravityFields/BaseGravityFieldComponent.h"
+#include "MGG/Utils/Subsystems/GravityWorldSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Algo/BinarySearch.h"
+
+/**
+ * @brief Adds a gravity field to the fields affecting this object.
+ *
+ * @details Fields are stored as registry handles with their priority, in a small inline array,
+ * so the common case of one to four fields never allocates and membership scans never touch
+ * a UObject. The entry is inserted in priority then registration order, so GravityFields stays
+ * sorted and the active field (highest priority, latest registered on a tie, like every other
+ * active field selection) is always the last one, whatever order the fields were entered in.
+ * Entries of fields that were unregistered meanwhile are dropped on the way.
+ *
+ * @param GravityField The field the object entered.
+ */
+void IGravityAffected::AddGravityField(UBaseGravityFieldComponent* GravityField)
+{
+	UGravityWorldSubsystem* GravitySubsystem = GetGravitySubsystem();
+	if (!GravitySubsystem)
+	{
+		return;
+	}
+
+	const FGravityFieldHandle Handle = GravitySubsystem->GetGravityFieldHandle(GravityField);
+	if (!Handle.IsSet() || GravityFields.ContainsByPredicate([&Handle](const FGravityFieldEntry& Entry) { return Entry.Handle == Handle; }))
+	{
+		return;
+	}
+
+	const FGravityFieldHandle PreviousActiveHandle = GetActiveGravityFieldHandle();
+
+	PruneStaleGravityFields(*GravitySubsystem);
+	InsertGravityFieldEntry({ Handle, GravityField->GetGravityFieldPriority(), GravitySubsystem->GetRegistrationOrder(Handle) });
+
+	bActiveGravityFieldChanged |= GetActiveGravityFieldHandle() != PreviousActiveHandle;
+}
+
+/**
+ * @brief Removes a gravity field from the fields affecting this object.
+ *
+ * @details Removing keeps the remaining fields in order, so no sort is needed. The entry is
+ * matched on the handle alone, so the handle of a field that was unregistered meanwhile still
+ * removes it.
+ *
+ * @param Handle The handle of the field the object left.
+ * @return True if the field was affecting this object.
+ */
+bool IGravityAffected::RemoveGravityField(FGravityFieldHandle Handle)
+{
+	if (!Handle.IsSet())
+	{
+		return false;
+	}
+
+	const int32 EntryIndex = GravityFields.IndexOfByPredicate([&Handle](const FGravityFieldEntry& Entry) { return Entry.Handle == Handle; });
+	if (EntryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FGravityFieldHandle PreviousActiveHandle = GetActiveGravityFieldHandle();
+
+	GravityFields.RemoveAt(EntryIndex, 1, EAllowShrinking::No);
+
+	bActiveGravityFieldChanged |= GetActiveGravityFieldHandle() != PreviousActiveHandle;
+	return true;
+}
+
+/**
+ * @brief Removes a gravity field and notifies the object if its active field changed.
+ *
+ * @details Whether the field was the active one is read from the entry handles before anything
+ * is pruned, so leaving a field that is being unregistered is still seen as leaving the active
+ * field. The object then receives OnEnterGravityField with the gravity of its new active field,
+ * or OnExitGravityField if no field is left.
+ *
+ * @param Handle The handle of the field the object left.
+ */
+void IGravityAffected::LeaveGravityField(FGravityFieldHandle Handle)
+{
+	const bool bWasActiveField = Handle.IsSet() && GetActiveGravityFieldHandle() == Handle;
+
+	if (!RemoveGravityField(Handle) || !bWasActiveField)
+	{
+		return;
+	}
+
+	UObject* AffectedObject = _getUObject();
+	const AActor* AffectedActor = Cast<AActor>(AffectedObject);
+	UBaseGravityFieldComponent* NewActiveField = GetActiveGravityField();
+
+	if (NewActiveField && AffectedActor)
+	{
+		FVector GravityVector = NewActiveField->CalculateGravityVector(AffectedActor->GetActorLocation());
+		IGravityAffected::Execute_OnEnterGravityField(AffectedObject, GravityVector);
+	}
+	else
+	{
+		IGravityAffected::Execute_OnExitGravityField(AffectedObject);
+	}
+}
+
+/**
+ * @brief Moves a gravity field to its new place after its priority changed.
+ *
+ * @param GravityField The field whose priority changed.
+ */
+void IGravityAffected::RefreshGravityFieldPriority(UBaseGravityFieldComponent* GravityField)
+{
+	const FGravityFieldHandle Handle = GravityField->GetGravityFieldHandle();
+	const int32 EntryIndex = GravityFields.IndexOfByPredicate([&Handle](const FGravityFieldEntry& Entry) { return Entry.Handle == Handle; });
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FGravityFieldHandle PreviousActiveHandle = GetActiveGravityFieldHandle();
+
+	FGravityFieldEntry Entry = GravityFields[EntryIndex];
+	Entry.Priority = GravityField->GetGravityFieldPriority();
+
+	GravityFields.RemoveAt(EntryIndex, 1, EAllowShrinking::No);
+	InsertGravityFieldEntry(Entry);
+
+	bActiveGravityFieldChanged |= GetActiveGravityFieldHandle() != PreviousActiveHandle;
+}
 
 /**
  * @brief Gets the active gravity field affecting this object.
  *
- * @details Analyzes all gravity fields currently overlapping with this object
- * and determines which one has the highest priority. This method is used internally
- * to select which gravity field should be used for physics calculations.
+ * @details The active field is the last entry of the sorted field list: the highest priority
+ * field, or the latest registered one on a tie. If that field was unregistered (e.g. destroyed while
+ * the object was inside it), its stale handle no longer resolves: the entry is dropped and the next
+ * one is used, so a dangling field can never be returned.
  * 
  * The priority system allows for complex scenarios where multiple gravity fields
  * overlap, ensuring that the most relevant field (e.g., a small planet's gravity
@@ -20,18 +148,73 @@ UBaseGravityFieldComponent* IGravityAffected::GetActiveGravityField()
 	{
 		return nullptr;
 	}
-	
-	UBaseGravityFieldComponent* ActiveField = GravityFields.Last();
-	int32 HighestPriority = ActiveField->GetGravityFieldPriority();
 
-	for (auto* Field : GravityFields)
+	const UGravityWorldSubsystem* GravitySubsystem = GetGravitySubsystem();
+	if (!GravitySubsystem)
+	{
+		return nullptr;
+	}
+
+	while (GravityFields.Num() > 0)
 	{
-		if (Field->GetGravityFieldPriority() > HighestPriority)
+		if (UBaseGravityFieldComponent* ActiveField = GravitySubsystem->ResolveGravityField(GravityFields.Last().Handle))
 		{
-			HighestPriority = Field->GetGravityFieldPriority();
-			ActiveField = Field;
+			return ActiveField;
 		}
+
+		GravityFields.Pop(EAllowShrinking::No);
+		bActiveGravityFieldChanged = true;
 	}
-    
-	return ActiveField;	
+
+	return nullptr;
+}
+
+/**
+ * @brief Reads and clears the "active field changed" flag.
+ *
+ * @details The flag is raised whenever adding, removing or re-prioritizing a field, or dropping
+ * a stale one, changes the active field. Code that only depends on which field is active
+ * (not on the object's position) can skip its work while the flag stays down.
+ *
+ * @return True if the active field changed since the last call.
+ */
+bool IGravityAffected::ConsumeActiveGravityFieldChanged()
+{
+	const bool bChanged = bActiveGravityFieldChanged;
+	bActiveGravityFieldChanged = false;
+	return bChanged;
+}
+
+/**
+ * @brief Gets the gravity subsystem of the world this object lives in.
+ *
+ * @return The gravity subsystem resolving this object's field handles, or nullptr.
+ */
+UGravityWorldSubsystem* IGravityAffected::GetGravitySubsystem() const
+{
+	return UGravityWorldSubsystem::Get(_getUObject());
+}
+
+/**
+ * @brief Drops the entries whose field handle no longer resolves.
+ *
+ * @param GravitySubsystem The gravity subsystem owning the field registry.
+ */
+void IGravityAffected::PruneStaleGravityFields(const UGravityWorldSubsystem& GravitySubsystem)
+{
+	GravityFields.RemoveAll([&GravitySubsystem](const FGravityFieldEntry& Entry) { return !GravitySubsystem.IsValidHandle(Entry.Handle); });
+}
+
+/**
+ * @brief Inserts an entry after every entry of lower priority, or of equal priority and earlier registration.
+ *
+ * @param Entry The entry to insert.
+ */
+void IGravityAffected::InsertGravityFieldEntry(const FGravityFieldEntry& Entry)
+{
+	const int32 InsertIndex = Algo::UpperBound(GravityFields, Entry, [](const FGravityFieldEntry& A, const FGravityFieldEntry& B)
+	{
+		return A.Priority != B.Priority ? A.Priority < B.Priority : A.RegistrationOrder < B.RegistrationOrder;
+	});
+	GravityFields.Insert(Entry, InsertIndex);
 }
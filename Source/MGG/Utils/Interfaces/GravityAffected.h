@@ -2,11 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Interface.h"
+#include "MGG/GravityFields/GravityFieldHandle.h"
 #include "GravityAffected.generated.h"
 
 //////// FORWARD DECLARATION ////////
 //// Class
 class UBaseGravityFieldComponent;
+class UGravityWorldSubsystem;
 
 /**
  * @brief Interface for objects that can be affected by gravity fields.
@@ -52,6 +54,16 @@ public:
 	 */
 	virtual void UpdateCurrentGravityField() = 0;
 
+	/**
+	 * @brief Tells whether this object blends every field containing it.
+	 *
+	 * @details Read by the gravity subsystem's central update pass. When true, the object's
+	 * gravity is composited from all the fields containing it instead of only the active one.
+	 *
+	 * @return True to blend overlapping fields, false to use the active field only.
+	 */
+	virtual bool ShouldBlendGravityFields() const { return false; }
+
 	//// Gravity events
 	/**
 	 * @brief Notifies the object that it has entered a gravity field.
@@ -77,11 +89,36 @@ public:
 	void OnExitGravityField();
 	virtual void OnExitGravityField_Implementation() = 0;
 
+	//////// STRUCTS ////////
+	struct FGravityFieldEntry
+	{
+		FGravityFieldHandle Handle;
+		int32 Priority;
+		uint32 RegistrationOrder;
+	};
+
 	//////// FIELDS ////////
 	//// Gravity fields
-	TArray<UBaseGravityFieldComponent*> GravityFields;
+	TArray<FGravityFieldEntry, TInlineAllocator<4>> GravityFields; // Sorted by ascending priority then registration, the active field is the last one
+	bool bActiveGravityFieldChanged = false;
 
 	//////// METHODS ////////
 	//// Helper methods
+	void AddGravityField(UBaseGravityFieldComponent* GravityField);
+	bool RemoveGravityField(FGravityFieldHandle Handle);
+	void LeaveGravityField(FGravityFieldHandle Handle);
+	void RefreshGravityFieldPriority(UBaseGravityFieldComponent* GravityField);
 	UBaseGravityFieldComponent* GetActiveGravityField();
+	bool ConsumeActiveGravityFieldChanged();
+
+private:
+	//////// METHODS ////////
+	//// Helper methods
+	UGravityWorldSubsystem* GetGravitySubsystem() const;
+	void PruneStaleGravityFields(const UGravityWorldSubsystem& GravitySubsystem);
+	void InsertGravityFieldEntry(const FGravityFieldEntry& Entry);
+
+	//////// INLINE METHODS ////////
+	//// Getters accessors
+	FORCEINLINE FGravityFieldHandle GetActiveGravityFieldHandle() const { return GravityFields.Num() > 0 ? GravityFields.Last().Handle : FGravityFieldHandle(); }
 };
@@ -0,0 +1,429 @@
+﻿#include "GravityFieldAABBTree.h"
+
+/**
+ * @brief Constructor for the gravity field AABB tree.
+ *
+ * @param InFatMargin The distance by which leaf bounds are grown, so that small field
+ * movements are absorbed without touching the tree structure.
+ */
+FGravityFieldAABBTree::FGravityFieldAABBTree(float InFatMargin) : FatMargin(InFatMargin)
+{
+
+}
+
+/**
+ * @brief Inserts a gravity field in the tree.
+ *
+ * @param Bounds The world bounds of the gravity field volume.
+ * @param GravityField The handle of the gravity field stored in the new leaf.
+ * @return The proxy identifier to use for later moves and removal.
+ */
+int32 FGravityFieldAABBTree::CreateProxy(const FBox& Bounds, FGravityFieldHandle GravityField)
+{
+	const int32 ProxyId = AllocateNode();
+	Nodes[ProxyId].Bounds = Bounds.ExpandBy(FatMargin);
+	Nodes[ProxyId].GravityField = GravityField;
+	Nodes[ProxyId].Height = 0;
+
+	InsertLeaf(ProxyId);
+	return ProxyId;
+}
+
+/**
+ * @brief Removes a gravity field from the tree.
+ *
+ * @param ProxyId The proxy identifier returned by CreateProxy.
+ */
+void FGravityFieldAABBTree::DestroyProxy(int32 ProxyId)
+{
+	check(Nodes.IsValidIndex(ProxyId) && Nodes[ProxyId].IsLeaf());
+
+	RemoveLeaf(ProxyId);
+	FreeNode(ProxyId);
+}
+
+/**
+ * @brief Updates the bounds of a gravity field after it moved or changed size.
+ *
+ * @details If the new bounds still fit inside the leaf's fat bounds, nothing happens.
+ * Otherwise the leaf is removed and reinserted with new fat bounds, which only touches
+ * the nodes on its path to the root.
+ *
+ * @param ProxyId The proxy identifier returned by CreateProxy.
+ * @param Bounds The new world bounds of the gravity field volume.
+ * @return True if the tree had to be restructured.
+ */
+bool FGravityFieldAABBTree::MoveProxy(int32 ProxyId, const FBox& Bounds)
+{
+	check(Nodes.IsValidIndex(ProxyId) && Nodes[ProxyId].IsLeaf());
+
+	if (Nodes[ProxyId].Bounds.IsInside(Bounds))
+	{
+		return false;
+	}
+
+	RemoveLeaf(ProxyId);
+	Nodes[ProxyId].Bounds = Bounds.ExpandBy(FatMargin);
+	InsertLeaf(ProxyId);
+	return true;
+}
+
+/**
+ * @brief Removes every proxy from the tree.
+ */
+void FGravityFieldAABBTree::Reset()
+{
+	Nodes.Reset();
+	Root = NullNode;
+	FreeList = NullNode;
+}
+
+/**
+ * @brief Finds the gravity fields whose bounds contain a point.
+ *
+ * @details Walks the tree with an explicit stack and only descends into nodes whose bounds
+ * contain the point.
+ *
+ * @param Point The world location to test.
+ * @param OnCandidate Called for each gravity field whose fat bounds contain the point.
+ */
+void FGravityFieldAABBTree::QueryPoint(const FVector& Point, TFunctionRef<void(FGravityFieldHandle)> OnCandidate) const
+{
+	if (Root == NullNode)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(Root);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+
+		if (!Node.Bounds.IsInsideOrOn(Point))
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			OnCandidate(Node.GravityField);
+		}
+		else
+		{
+			Stack.Push(Node.Left);
+			Stack.Push(Node.Right);
+		}
+	}
+}
+
+/**
+ * @brief Finds the gravity fields whose bounds contain each point of a batch.
+ *
+ * @param Points The world locations to test.
+ * @param OnCandidate Called with the point index and the gravity field for every match.
+ */
+void FGravityFieldAABBTree::QueryPoints(TConstArrayView<FVector> Points, TFunctionRef<void(int32, FGravityFieldHandle)> OnCandidate) const
+{
+	for (int32 PointIndex = 0; PointIndex < Points.Num(); ++PointIndex)
+	{
+		QueryPoint(Points[PointIndex], [&OnCandidate, PointIndex](FGravityFieldHandle GravityField)
+		{
+			OnCandidate(PointIndex, GravityField);
+		});
+	}
+}
+
+/**
+ * @brief Finds the gravity fields whose bounds intersect a box.
+ *
+ * @details Same walk as QueryPoint, descending into the nodes whose bounds intersect the box.
+ * Used to gather, once for a whole group of points, the only fields any of them can be in.
+ *
+ * @param Box The world box to test.
+ * @param OnCandidate Called for each gravity field whose fat bounds intersect the box.
+ */
+void FGravityFieldAABBTree::QueryBox(const FBox& Box, TFunctionRef<void(FGravityFieldHandle)> OnCandidate) const
+{
+	if (Root == NullNode || !Box.IsValid)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(Root);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+
+		if (!Node.Bounds.Intersect(Box))
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			OnCandidate(Node.GravityField);
+		}
+		else
+		{
+			Stack.Push(Node.Left);
+			Stack.Push(Node.Right);
+		}
+	}
+}
+
+/**
+ * @brief Takes a node from the free list, or grows the node pool.
+ *
+ * @return The index of a node ready to be filled.
+ */
+int32 FGravityFieldAABBTree::AllocateNode()
+{
+	if (FreeList == NullNode)
+	{
+		FreeList = Nodes.AddDefaulted();
+	}
+
+	const int32 NodeId = FreeList;
+	FreeList = Nodes[NodeId].Parent;
+	Nodes[NodeId] = FNode();
+	return NodeId;
+}
+
+/**
+ * @brief Returns a node to the free list.
+ *
+ * @param NodeId The node to release.
+ */
+void FGravityFieldAABBTree::FreeNode(int32 NodeId)
+{
+	Nodes[NodeId] = FNode();
+	Nodes[NodeId].Parent = FreeList;
+	FreeList = NodeId;
+}
+
+/**
+ * @brief Inserts a leaf next to the sibling that minimizes the tree's surface area.
+ *
+ * @details Uses the classic surface area heuristic: at each level, descend into the child
+ * whose bounds grow the least, or stop and pair with the current node if that is cheaper.
+ *
+ * @param Leaf The leaf node to insert.
+ */
+void FGravityFieldAABBTree::InsertLeaf(int32 Leaf)
+{
+	if (Root == NullNode)
+	{
+		Root = Leaf;
+		Nodes[Root].Parent = NullNode;
+		return;
+	}
+
+	const FBox LeafBounds = Nodes[Leaf].Bounds;
+	int32 Index = Root;
+
+	while (!Nodes[Index].IsLeaf())
+	{
+		const FNode& Node = Nodes[Index];
+		const float Area = SurfaceArea(Node.Bounds);
+		const float CombinedArea = SurfaceArea(Node.Bounds + LeafBounds);
+
+		const float Cost = 2.0f * CombinedArea;
+		const float InheritanceCost = 2.0f * (CombinedArea - Area);
+
+		auto ChildCost = [this, &LeafBounds, InheritanceCost](int32 Child)
+		{
+			const FNode& ChildNode = Nodes[Child];
+			const float ChildCombinedArea = SurfaceArea(ChildNode.Bounds + LeafBounds);
+			return ChildNode.IsLeaf() ? ChildCombinedArea + InheritanceCost : ChildCombinedArea - SurfaceArea(ChildNode.Bounds) + InheritanceCost;
+		};
+
+		const float CostLeft = ChildCost(Node.Left);
+		const float CostRight = ChildCost(Node.Right);
+
+		if (Cost < CostLeft && Cost < CostRight)
+		{
+			break;
+		}
+
+		Index = CostLeft < CostRight ? Node.Left : Node.Right;
+	}
+
+	const int32 Sibling = Index;
+	const int32 OldParent = Nodes[Sibling].Parent;
+	const int32 NewParent = AllocateNode();
+
+	Nodes[NewParent].Parent = OldParent;
+	Nodes[NewParent].Bounds = LeafBounds + Nodes[Sibling].Bounds;
+	Nodes[NewParent].Height = Nodes[Sibling].Height + 1;
+	Nodes[NewParent].Left = Sibling;
+	Nodes[NewParent].Right = Leaf;
+	Nodes[Sibling].Parent = NewParent;
+	Nodes[Leaf].Parent = NewParent;
+
+	if (OldParent != NullNode)
+	{
+		if (Nodes[OldParent].Left == Sibling)
+		{
+			Nodes[OldParent].Left = NewParent;
+		}
+		else
+		{
+			Nodes[OldParent].Right = NewParent;
+		}
+	}
+	else
+	{
+		Root = NewParent;
+	}
+
+	RefitAncestors(Nodes[Leaf].Parent);
+}
+
+/**
+ * @brief Detaches a leaf from the tree, replacing its parent with its sibling.
+ *
+ * @param Leaf The leaf node to remove.
+ */
+void FGravityFieldAABBTree::RemoveLeaf(int32 Leaf)
+{
+	if (Leaf == Root)
+	{
+		Root = NullNode;
+		return;
+	}
+
+	const int32 Parent = Nodes[Leaf].Parent;
+	const int32 GrandParent = Nodes[Parent].Parent;
+	const int32 Sibling = Nodes[Parent].Left == Leaf ? Nodes[Parent].Right : Nodes[Parent].Left;
+
+	if (GrandParent != NullNode)
+	{
+		if (Nodes[GrandParent].Left == Parent)
+		{
+			Nodes[GrandParent].Left = Sibling;
+		}
+		else
+		{
+			Nodes[GrandParent].Right = Sibling;
+		}
+		Nodes[Sibling].Parent = GrandParent;
+		FreeNode(Parent);
+
+		RefitAncestors(GrandParent);
+	}
+	else
+	{
+		Root = Sibling;
+		Nodes[Sibling].Parent = NullNode;
+		FreeNode(Parent);
+	}
+
+	Nodes[Leaf].Parent = NullNode;
+}
+
+/**
+ * @brief Rebalances and recomputes bounds and heights from a node up to the root.
+ *
+ * @param NodeId The first node to refit.
+ */
+void FGravityFieldAABBTree::RefitAncestors(int32 NodeId)
+{
+	int32 Index = NodeId;
+
+	while (Index != NullNode)
+	{
+		Index = Balance(Index);
+
+		FNode& Node = Nodes[Index];
+		Node.Height = 1 + FMath::Max(Nodes[Node.Left].Height, Nodes[Node.Right].Height);
+		Node.Bounds = Nodes[Node.Left].Bounds + Nodes[Node.Right].Bounds;
+
+		Index = Node.Parent;
+	}
+}
+
+/**
+ * @brief Performs a tree rotation if a node's subtrees differ in height by more than one.
+ *
+ * @details Promotes the taller child to the node's position, which keeps the tree
+ * height logarithmic regardless of insertion order.
+ *
+ * @param NodeId The node to balance.
+ * @return The index of the node now occupying the balanced position.
+ */
+int32 FGravityFieldAABBTree::Balance(int32 NodeId)
+{
+	const int32 A = NodeId;
+	if (Nodes[A].IsLeaf() || Nodes[A].Height < 2)
+	{
+		return A;
+	}
+
+	const int32 B = Nodes[A].Left;
+	const int32 C = Nodes[A].Right;
+	const int32 HeightDifference = Nodes[C].Height - Nodes[B].Height;
+
+	// Promotes Child (the taller subtree of A) in place of A
+	auto Rotate = [this, A](int32 Child, int32 Other, bool bChildIsRight) -> int32
+	{
+		const int32 F = Nodes[Child].Left;
+		const int32 G = Nodes[Child].Right;
+
+		Nodes[Child].Left = A;
+		Nodes[Child].Parent = Nodes[A].Parent;
+		Nodes[A].Parent = Child;
+
+		if (Nodes[Child].Parent != NullNode)
+		{
+			FNode& ChildParent = Nodes[Nodes[Child].Parent];
+			if (ChildParent.Left == A)
+			{
+				ChildParent.Left = Child;
+			}
+			else
+			{
+				ChildParent.Right = Child;
+			}
+		}
+		else
+		{
+			Root = Child;
+		}
+
+		const int32 Kept = Nodes[F].Height > Nodes[G].Height ? F : G;
+		const int32 Moved = Kept == F ? G : F;
+
+		Nodes[Child].Right = Kept;
+		if (bChildIsRight)
+		{
+			Nodes[A].Right = Moved;
+		}
+		else
+		{
+			Nodes[A].Left = Moved;
+		}
+		Nodes[Moved].Parent = A;
+
+		Nodes[A].Bounds = Nodes[Other].Bounds + Nodes[Moved].Bounds;
+		Nodes[A].Height = 1 + FMath::Max(Nodes[Other].Height, Nodes[Moved].Height);
+		Nodes[Child].Bounds = Nodes[A].Bounds + Nodes[Kept].Bounds;
+		Nodes[Child].Height = 1 + FMath::Max(Nodes[A].Height, Nodes[Kept].Height);
+
+		return Child;
+	};
+
+	if (HeightDifference > 1)
+	{
+		return Rotate(C, B, true);
+	}
+	if (HeightDifference < -1)
+	{
+		return Rotate(B, C, false);
+	}
+
+	return A;
+}
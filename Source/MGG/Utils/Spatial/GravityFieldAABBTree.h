@@ -0,0 +1,75 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MGG/GravityFields/GravityFieldHandle.h"
+
+/**
+ * @brief Dynamic bounding-volume hierarchy over gravity field volumes.
+ *
+ * @details Each gravity field is stored as a leaf holding a "fat" axis-aligned box
+ * (its bounds grown by a margin) so small movements of a field do not require any
+ * restructuring. Internal nodes are kept balanced with tree rotations, which keeps point
+ * queries logarithmic in the number of fields even with hundreds of nested planets.
+ *
+ * The tree is only a broad phase: it returns the fields whose bounds contain a point.
+ * Callers are expected to run the exact volume test on the returned candidates.
+ */
+class MGG_API FGravityFieldAABBTree
+{
+public:
+	//////// CONSTRUCTOR ////////
+	explicit FGravityFieldAABBTree(float InFatMargin = 100.0f);
+
+	//////// METHODS ////////
+	//// Proxy methods
+	int32 CreateProxy(const FBox& Bounds, FGravityFieldHandle GravityField);
+	void DestroyProxy(int32 ProxyId);
+	bool MoveProxy(int32 ProxyId, const FBox& Bounds);
+	void Reset();
+
+	//// Query methods
+	void QueryPoint(const FVector& Point, TFunctionRef<void(FGravityFieldHandle)> OnCandidate) const;
+	void QueryPoints(TConstArrayView<FVector> Points, TFunctionRef<void(int32, FGravityFieldHandle)> OnCandidate) const;
+	void QueryBox(const FBox& Box, TFunctionRef<void(FGravityFieldHandle)> OnCandidate) const;
+
+	//////// INLINE METHODS ////////
+	//// Getters accessors
+	FORCEINLINE FGravityFieldHandle GetGravityField(int32 ProxyId) const { return Nodes[ProxyId].GravityField; }
+	FORCEINLINE const FBox& GetFatBounds(int32 ProxyId) const { return Nodes[ProxyId].Bounds; }
+	FORCEINLINE int32 GetHeight() const { return Root != NullNode ? Nodes[Root].Height : 0; }
+
+private:
+	//////// STRUCTS ////////
+	struct FNode
+	{
+		FBox Bounds = FBox(ForceInit);
+		FGravityFieldHandle GravityField;
+		int32 Parent = INDEX_NONE; // Next free node when the node is in the free list
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+		int32 Height = INDEX_NONE; // INDEX_NONE when the node is free
+
+		FORCEINLINE bool IsLeaf() const { return Left == INDEX_NONE; }
+	};
+
+	//////// FIELDS ////////
+	//// Tree fields
+	static constexpr int32 NullNode = INDEX_NONE;
+	TArray<FNode> Nodes;
+	int32 Root = NullNode;
+	int32 FreeList = NullNode;
+	float FatMargin;
+
+	//////// METHODS ////////
+	//// Tree methods
+	int32 AllocateNode();
+	void FreeNode(int32 NodeId);
+	void InsertLeaf(int32 Leaf);
+	void RemoveLeaf(int32 Leaf);
+	void RefitAncestors(int32 NodeId);
+	int32 Balance(int32 NodeId);
+
+	//////// INLINE METHODS ////////
+	//// Helper methods
+	FORCEINLINE static float SurfaceArea(const FBox& Box) { const FVector Size = Box.GetSize(); return 2.0f * (Size.X * Size.Y + Size.Y * Size.Z + Size.Z * Size.X); }
+};
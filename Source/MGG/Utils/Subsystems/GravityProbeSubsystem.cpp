@@ -0,0 +1,216 @@
+﻿#include "GravityProbeSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Components/PrimitiveComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "MGG/GravityFields/GravityStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ground Probe Submission"), STAT_GravityGroundProbeSubmission, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Async Ground Probes"), STAT_GravityAsyncGroundProbes, STATGROUP_MGGGravity);
+
+static bool GGravityAsyncGroundProbes = true;
+static FAutoConsoleVariableRef CVarGravityAsyncGroundProbes(
+	TEXT("mgg.Gravity.AsyncGroundProbes"),
+	GGravityAsyncGroundProbes,
+	TEXT("Runs the ground probes of gravity-affected actors as batched async sweeps, delivered next frame. Disable to make them sweep synchronously on the game thread."));
+
+/**
+ * @brief Called when the subsystem is created for its world.
+ *
+ * @param Collection The subsystem collection this subsystem belongs to.
+ */
+void UGravityProbeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GroundProbeDelegate.BindUObject(this, &UGravityProbeSubsystem::OnGroundProbeDone);
+
+	ProbeTick.Target = this;
+	ProbeTick.TickGroup = TG_PostUpdateWork;
+	ProbeTick.bCanEverTick = true;
+	ProbeTick.bStartWithTickEnabled = true;
+}
+
+/**
+ * @brief Called when the world owning this subsystem is torn down.
+ *
+ * @details Unbinds the trace delegate, so traces still in flight deliver nothing.
+ */
+void UGravityProbeSubsystem::Deinitialize()
+{
+	if (ProbeTick.IsTickFunctionRegistered())
+	{
+		ProbeTick.UnRegisterTickFunction();
+	}
+
+	GroundProbeDelegate.Unbind();
+	PendingProbes.Reset();
+	InFlightProbes.Reset();
+	ProbeResults.Reset();
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Called when the world owning this subsystem begins play.
+ *
+ * @param InWorld The world beginning play.
+ */
+void UGravityProbeSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ProbeTick.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+/**
+ * @brief Requests a ground probe for a component, delivered next frame.
+ *
+ * @details The probe sweeps the component's collision shape from Start to End, with the
+ * component's rotation, collision channel and responses, ignoring its owner.
+ *
+ * @param Component The component to probe the ground for.
+ * @param Start The start of the sweep.
+ * @param End The end of the sweep.
+ */
+void UGravityProbeSubsystem::RequestGroundProbe(UPrimitiveComponent* Component, const FVector& Start, const FVector& End)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	FGroundProbe& Probe = PendingProbes.FindOrAdd(Component);
+	Probe.Start = Start;
+	Probe.End = End;
+	Probe.Rotation = Component->GetComponentQuat();
+	Probe.Shape = Component->GetCollisionShape();
+	Probe.Channel = Component->GetCollisionObjectType();
+	Probe.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(GravityGroundProbe), false, Component->GetOwner());
+	Probe.ResponseParams = FCollisionResponseParams();
+	Component->InitSweepCollisionParams(Probe.QueryParams, Probe.ResponseParams);
+}
+
+/**
+ * @brief Takes the result of the last ground probe delivered for a component.
+ *
+ * @param Component The component the probe was requested for.
+ * @param OutHit Receives the probe's first blocking hit; bBlockingHit is false if the probe hit nothing.
+ * @return True if a result was waiting, false if none was delivered since the last call.
+ */
+bool UGravityProbeSubsystem::ConsumeGroundProbe(const UPrimitiveComponent* Component, FHitResult& OutHit)
+{
+	return ProbeResults.RemoveAndCopyValue(Component, OutHit);
+}
+
+/**
+ * @brief Submits every ground probe requested this frame as async sweeps.
+ *
+ * @details Called once per frame by the probe tick function. Each sweep carries the index of
+ * its component in the submitted batch, which is how its result finds its way back.
+ */
+void UGravityProbeSubsystem::SubmitGroundProbes()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GravityGroundProbeSubmission);
+
+	UWorld* World = GetWorld();
+	if (!World || PendingProbes.Num() == 0)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_GravityAsyncGroundProbes, PendingProbes.Num());
+
+	InFlightProbes.Reset(PendingProbes.Num());
+
+	for (const TPair<TObjectKey<UPrimitiveComponent>, FGroundProbe>& PendingProbe : PendingProbes)
+	{
+		const FGroundProbe& Probe = PendingProbe.Value;
+		const uint32 ProbeIndex = InFlightProbes.Add(PendingProbe.Key);
+
+		World->AsyncSweepByChannel(EAsyncTraceType::Single, Probe.Start, Probe.End, Probe.Rotation, Probe.Channel, Probe.Shape, Probe.QueryParams, Probe.ResponseParams, &GroundProbeDelegate, ProbeIndex);
+	}
+
+	PendingProbes.Reset();
+}
+
+/**
+ * @brief Stores the result of a finished ground probe.
+ *
+ * @details Called by the async trace system at the start of the frame following the submission.
+ *
+ * @param TraceHandle The handle of the finished trace.
+ * @param TraceData The trace request and its hits.
+ */
+void UGravityProbeSubsystem::OnGroundProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	const int32 ProbeIndex = static_cast<int32>(TraceData.UserData);
+	if (!InFlightProbes.IsValidIndex(ProbeIndex))
+	{
+		return;
+	}
+
+	FHitResult& Result = ProbeResults.FindOrAdd(InFlightProbes[ProbeIndex]);
+	Result = TraceData.OutHits.Num() > 0 ? TraceData.OutHits[0] : FHitResult(TraceData.Start, TraceData.End);
+}
+
+/**
+ * @brief Gets the ground probe subsystem of the world an object lives in.
+ *
+ * @param WorldContextObject Any object living in the target world.
+ * @return The ground probe subsystem, or nullptr if the object has no world.
+ */
+UGravityProbeSubsystem* UGravityProbeSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr)
+	{
+		return World->GetSubsystem<UGravityProbeSubsystem>();
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Tells whether ground probes should go through this subsystem.
+ *
+ * @return The value of mgg.Gravity.AsyncGroundProbes.
+ */
+bool UGravityProbeSubsystem::IsAsyncProbingEnabled()
+{
+	return GGravityAsyncGroundProbes;
+}
+
+/**
+ * @brief Submits the ground probes gathered by the target subsystem.
+ *
+ * @param DeltaTime The frame delta time.
+ * @param TickType The kind of tick being performed.
+ * @param CurrentThread The thread this tick runs on.
+ * @param MyCompletionGraphEvent The completion event of this tick.
+ */
+void FGravityProbeTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->SubmitGroundProbes();
+	}
+}
+
+/**
+ * @brief Describes this tick function in tick diagnostics.
+ *
+ * @return The diagnostic description.
+ */
+FString FGravityProbeTickFunction::DiagnosticMessage()
+{
+	return TEXT("FGravityProbeTickFunction");
+}
+
+/**
+ * @brief Names this tick function in tick diagnostics and CSV stats.
+ *
+ * @param bDetailed Whether a detailed context is requested.
+ * @return The diagnostic context name.
+ */
+FName FGravityProbeTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("GravityProbeTick"));
+}
@@ -0,0 +1,108 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "GravityProbeSubsystem.generated.h"
+
+//////// FORWARD DECLARATION ////////
+//// Class
+class UPrimitiveComponent;
+class UGravityProbeSubsystem;
+
+/**
+ * @brief Tick function submitting the ground probes gathered during the frame.
+ *
+ * @details Registered by the probe subsystem in TG_PostUpdateWork, after every movement of the
+ * frame, so the whole batch is handed to the async trace system before it starts its tasks.
+ */
+USTRUCT()
+struct FGravityProbeTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	//////// FIELDS ////////
+	UGravityProbeSubsystem* Target = nullptr;
+
+	//////// METHODS ////////
+	//// FTickFunction implementation
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGravityProbeTickFunction> : public TStructOpsTypeTraitsBase2<FGravityProbeTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * @brief Batched asynchronous ground probes for gravity-affected actors.
+ *
+ * @details Actors that cannot rely on the analytic planet surface (props, moving platforms)
+ * request a ground probe here instead of tracing on the game thread. All the probes requested
+ * during a frame are submitted together at the end of it as async sweeps, which the engine runs
+ * on worker threads; the results are delivered at the start of the next frame, and each actor
+ * picks its own up with ConsumeGroundProbe. A component requesting several probes in the same
+ * frame only keeps its last one.
+ *
+ * The one-frame latency is the price of removing the traces from the game thread: callers
+ * must be written to act on last frame's result. "mgg.Gravity.AsyncGroundProbes 0" makes
+ * callers go back to their synchronous sweeps, for comparisons.
+ */
+UCLASS()
+class MGG_API UGravityProbeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//////// UNREAL LIFECYCLE ////////
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	//////// METHODS ////////
+	//// Static methods
+	static UGravityProbeSubsystem* Get(const UObject* WorldContextObject);
+	static bool IsAsyncProbingEnabled();
+
+	//// Probe methods
+	void RequestGroundProbe(UPrimitiveComponent* Component, const FVector& Start, const FVector& End);
+	bool ConsumeGroundProbe(const UPrimitiveComponent* Component, FHitResult& OutHit);
+
+	//// Update methods
+	void SubmitGroundProbes();
+
+private:
+	//////// STRUCTS ////////
+	struct FGroundProbe
+	{
+		FVector Start;
+		FVector End;
+		FQuat Rotation;
+		FCollisionShape Shape;
+		ECollisionChannel Channel;
+		FCollisionQueryParams QueryParams;
+		FCollisionResponseParams ResponseParams;
+	};
+
+	//////// FIELDS ////////
+	//// Probe fields
+	TMap<TObjectKey<UPrimitiveComponent>, FGroundProbe> PendingProbes;
+	TArray<TObjectKey<UPrimitiveComponent>> InFlightProbes; // Components of the submitted batch, indexed by the traces' user data
+	TMap<TObjectKey<UPrimitiveComponent>, FHitResult> ProbeResults;
+	FTraceDelegate GroundProbeDelegate;
+
+	//// Tick fields
+	FGravityProbeTickFunction ProbeTick;
+
+	//////// METHODS ////////
+	//// Callback methods
+	void OnGroundProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+};
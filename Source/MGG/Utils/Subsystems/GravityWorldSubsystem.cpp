@@ -0,0 +1,867 @@
+﻿#include "GravityWorldSubsystem.h"
+#include "Engine/World.h"
+#include "Misc/ScopeRWLock.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "MGG/GravityFields/BaseGravityFieldComponent.h"
+#include "MGG/GravityFields/GravityFieldMath.h"
+#include "MGG/GravityFields/GravityStats.h"
+#include "MGG/Utils/Interfaces/GravityAffected.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gravity Update Pass"), STAT_GravityUpdatePass, STATGROUP_MGGGravity);
+DECLARE_CYCLE_STAT(TEXT("Gravity Dirty Flush"), STAT_GravityDirtyFlush, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Gravity Dirty Fields"), STAT_GravityDirtyFields, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Gravity Updated Actors"), STAT_GravityUpdatedActors, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Gravity Skipped Updates"), STAT_GravitySkippedUpdates, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Gravity Temporal Cache Hits"), STAT_GravityTemporalCacheHits, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Gravity Temporal Cache Misses"), STAT_GravityTemporalCacheMisses, STATGROUP_MGGGravity);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Gravity Temporal Cache Hit Rate (%)"), STAT_GravityTemporalCacheHitRate, STATGROUP_MGGGravity);
+
+static bool GGravityParallelUpdate = true;
+static FAutoConsoleVariableRef CVarGravityParallelUpdate(
+	TEXT("mgg.Gravity.ParallelUpdate"),
+	GGravityParallelUpdate,
+	TEXT("Evaluates the gravity of every gravity-affected actor across worker threads. Disable to run the update pass on the game thread only."));
+
+static float GGravityTemporalCacheTolerance = 1.0f;
+static FAutoConsoleVariableRef CVarGravityTemporalCacheTolerance(
+	TEXT("mgg.Gravity.TemporalCacheTolerance"),
+	GGravityTemporalCacheTolerance,
+	TEXT("Distance an actor may move from its last gravity sample before the sample is evaluated again, as long as its active field is unchanged. 0 disables the temporal cache."));
+
+static int32 GGravityUpdateRateMaxInterval = 8;
+static FAutoConsoleVariableRef CVarGravityUpdateRateMaxInterval(
+	TEXT("mgg.Gravity.UpdateRateMaxInterval"),
+	GGravityUpdateRateMaxInterval,
+	TEXT("Largest number of frames between two gravity evaluations of a distant or unseen actor. 1 updates every actor every frame."));
+
+static float GGravityUpdateRateNearDistance = 3000.0f;
+static FAutoConsoleVariableRef CVarGravityUpdateRateNearDistance(
+	TEXT("mgg.Gravity.UpdateRateNearDistance"),
+	GGravityUpdateRateNearDistance,
+	TEXT("Distance to the closest player view under which an actor's gravity is evaluated every frame."));
+
+static float GGravityUpdateRateFarDistance = 15000.0f;
+static FAutoConsoleVariableRef CVarGravityUpdateRateFarDistance(
+	TEXT("mgg.Gravity.UpdateRateFarDistance"),
+	GGravityUpdateRateFarDistance,
+	TEXT("Distance to the closest player view from which an actor's gravity is evaluated every mgg.Gravity.UpdateRateMaxInterval frames."));
+
+/**
+ * @brief Called when the subsystem is created for its world.
+ *
+ * @details Publishes an empty gravity scene so readers never get a null scene, and hooks
+ * the start of the world tick, which is the synchronization point where field snapshots
+ * are mirrored to the thread-safe scene.
+ *
+ * @param Collection The subsystem collection this subsystem belongs to.
+ */
+void UGravityWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GravityScene = MakeShared<FGravityFieldScene, ESPMode::ThreadSafe>();
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UGravityWorldSubsystem::OnWorldTickStart);
+
+	GravityUpdateTick.Target = this;
+	GravityUpdateTick.TickGroup = TG_PrePhysics;
+	GravityUpdateTick.bCanEverTick = true;
+	GravityUpdateTick.bStartWithTickEnabled = true;
+}
+
+/**
+ * @brief Called when the world owning this subsystem begins play.
+ *
+ * @details Registers the gravity update tick function, so the central update pass only
+ * runs in worlds that actually play.
+ *
+ * @param InWorld The world beginning play.
+ */
+void UGravityWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	GravityUpdateTick.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+/**
+ * @brief Called when the world owning this subsystem is torn down.
+ *
+ * @details Releases every registered gravity field so no stale pointer or handle survives the world.
+ */
+void UGravityWorldSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+
+	for (const FGravityAffectedEntry& Entry : AffectedEntries)
+	{
+		if (AActor* AffectedActor = Entry.Actor.Get())
+		{
+			AffectedActor->PrimaryActorTick.RemovePrerequisite(this, GravityUpdateTick);
+		}
+	}
+
+	AffectedEntries.Reset();
+	UpdateRequests.Reset();
+
+	if (GravityUpdateTick.IsTickFunctionRegistered())
+	{
+		GravityUpdateTick.UnRegisterTickFunction();
+	}
+
+	for (UBaseGravityFieldComponent* GravityField : GravityFields)
+	{
+		if (GravityField)
+		{
+			GravityField->RegistryHandle.Reset();
+		}
+	}
+
+	GravityFields.Reset();
+	DirtyFields.Reset();
+	FlushingFields.Reset();
+	FieldSlots.Reset();
+	FirstFreeSlot = INDEX_NONE;
+	FieldTree.Reset();
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Registers a gravity field with the subsystem.
+ *
+ * @details Called by the gravity field itself when it is registered with the scene.
+ * The field gets a registry slot (reused from the free list when possible) and a handle to it,
+ * and its bounds are inserted in the spatial index. Registering the same field twice is a no-op.
+ *
+ * @param GravityField The gravity field to register.
+ */
+void UGravityWorldSubsystem::RegisterGravityField(UBaseGravityFieldComponent* GravityField)
+{
+	if (!GravityField || ResolveGravityField(GravityField->GetGravityFieldHandle()) == GravityField)
+	{
+		return;
+	}
+
+	int32 SlotIndex = FirstFreeSlot;
+	if (SlotIndex != INDEX_NONE)
+	{
+		FirstFreeSlot = FieldSlots[SlotIndex].NextFreeSlot;
+	}
+	else
+	{
+		SlotIndex = FieldSlots.AddDefaulted();
+	}
+
+	FGravityFieldSlot& Slot = FieldSlots[SlotIndex];
+	const FGravityFieldHandle Handle = { SlotIndex, Slot.Generation };
+
+	Slot.GravityField = GravityField;
+	Slot.ProxyId = FieldTree.CreateProxy(GravityField->GetFieldBounds(), Handle);
+	Slot.Priority = GravityField->GetGravityFieldPriority();
+	Slot.RegistrationOrder = NextRegistrationOrder++;
+	Slot.NextFreeSlot = INDEX_NONE;
+
+	GravityField->RegistryHandle = Handle;
+	GravityFields.Add(GravityField);
+	bGravitySceneDirty = true;
+}
+
+/**
+ * @brief Unregisters a gravity field from the subsystem.
+ *
+ * @details Called by the gravity field when it is unregistered from the scene or destroyed.
+ * The slot's generation is bumped before the slot returns to the free list, so every handle
+ * still held on this field (e.g. by actors that were inside it) becomes stale.
+ *
+ * Every registered gravity-affected actor then leaves the field, as if its volume had ended
+ * overlapping it: an actor for which it was the active field is sent the enter or exit event of
+ * its new state. The field's end overlap events, if any follow, find no handle and do nothing.
+ *
+ * @param GravityField The gravity field to unregister.
+ */
+void UGravityWorldSubsystem::UnregisterGravityField(UBaseGravityFieldComponent* GravityField)
+{
+	if (!GravityField)
+	{
+		return;
+	}
+
+	const FGravityFieldHandle Handle = GravityField->GetGravityFieldHandle();
+	if (ResolveGravityField(Handle) != GravityField)
+	{
+		return;
+	}
+
+	FGravityFieldSlot& Slot = FieldSlots[Handle.Index];
+	FieldTree.DestroyProxy(Slot.ProxyId);
+
+	Slot.GravityField = nullptr;
+	Slot.ProxyId = INDEX_NONE;
+	Slot.Generation++;
+	Slot.NextFreeSlot = FirstFreeSlot;
+	FirstFreeSlot = Handle.Index;
+
+	if (GravityField->PendingDirtyFlags != EGravityFieldDirtyFlags::None)
+	{
+		GravityField->PendingDirtyFlags = EGravityFieldDirtyFlags::None;
+		DirtyFields.RemoveSingleSwap(GravityField, EAllowShrinking::No);
+	}
+
+	GravityField->RegistryHandle.Reset();
+	GravityFields.Remove(GravityField);
+	bGravitySceneDirty = true;
+
+	// Leaving fires the enter and exit events, whose handlers may destroy actors and unregister
+	// them from AffectedEntries, so the actors are collected before any of them is notified
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<16>> AffectedActors;
+	for (const FGravityAffectedEntry& Entry : AffectedEntries)
+	{
+		AffectedActors.Add(Entry.Actor);
+	}
+
+	for (const TWeakObjectPtr<AActor>& AffectedActor : AffectedActors)
+	{
+		if (IGravityAffected* GravityAffected = Cast<IGravityAffected>(AffectedActor.Get()))
+		{
+			GravityAffected->LeaveGravityField(Handle);
+		}
+	}
+}
+
+/**
+ * @brief Refits a gravity field in the spatial index after it moved, was resized or changed priority.
+ *
+ * @details Called by the gravity field whenever its dimensions are recalculated or its priority
+ * changes. The tree is only restructured when the new bounds leave the field's fat bounds.
+ *
+ * @param GravityField The gravity field that changed.
+ */
+void UGravityWorldSubsystem::UpdateGravityField(UBaseGravityFieldComponent* GravityField)
+{
+	const FGravityFieldHandle Handle = GravityField ? GravityField->GetGravityFieldHandle() : FGravityFieldHandle();
+	if (ResolveGravityField(Handle) != GravityField)
+	{
+		return;
+	}
+
+	FGravityFieldSlot& Slot = FieldSlots[Handle.Index];
+	Slot.Priority = GravityField->GetGravityFieldPriority();
+	FieldTree.MoveProxy(Slot.ProxyId, GravityField->GetFieldBounds());
+	bGravitySceneDirty = true;
+}
+
+/**
+ * @brief Adds a gravity field to the dirty list.
+ *
+ * @details Called by the field on its first change since the last flush, the field itself
+ * accumulates what changed until then (see UBaseGravityFieldComponent::MarkGravityFieldDirty).
+ *
+ * @param GravityField The gravity field that changed.
+ */
+void UGravityWorldSubsystem::EnqueueDirtyGravityField(UBaseGravityFieldComponent* GravityField)
+{
+	DirtyFields.Add(GravityField);
+}
+
+/**
+ * @brief Applies the queued changes of every dirty gravity field.
+ *
+ * @details Called at the start of the world tick and before the gravity update pass, each time
+ * before the gravity scene is published. Each field only rebuilds what its changes invalidated:
+ * volume, snapshot and baked cache, spatial index entry, debug drawing. Fields changed while
+ * flushing (e.g. by a volume update moving an attached field) are queued for the next flush.
+ */
+void UGravityWorldSubsystem::FlushDirtyGravityFields()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GravityDirtyFlush);
+	check(IsInGameThread());
+
+	Swap(DirtyFields, FlushingFields);
+	INC_DWORD_STAT_BY(STAT_GravityDirtyFields, FlushingFields.Num());
+
+	for (UBaseGravityFieldComponent* GravityField : FlushingFields)
+	{
+		if (ResolveGravityField(GravityField->GetGravityFieldHandle()) != GravityField)
+		{
+			continue;
+		}
+
+		if (EnumHasAnyFlags(GravityField->FlushDirtyState(), EGravityFieldDirtyFlags::Scene))
+		{
+			bGravitySceneDirty = true;
+		}
+	}
+
+	FlushingFields.Reset();
+}
+
+/**
+ * @brief Flushes the dirty list, then publishes the gravity scene if a field changed.
+ *
+ * @details Called at the start of every world tick, right before the gravity update pass, and by
+ * systems moving many fields during the frame (e.g. the planet motion pass) so queries made
+ * before the update pass see their new state. A flush with no dirty field costs nothing.
+ */
+void UGravityWorldSubsystem::SynchronizeGravityFields()
+{
+	FlushDirtyGravityFields();
+
+	if (bGravitySceneDirty)
+	{
+		PublishGravityScene();
+	}
+}
+
+/**
+ * @brief Makes the central gravity update pass wait for another tick function.
+ *
+ * @param TargetObject The object owning the prerequisite tick function.
+ * @param TargetTickFunction The tick function to run before the gravity update pass.
+ */
+void UGravityWorldSubsystem::AddGravityUpdatePrerequisite(UObject* TargetObject, FTickFunction& TargetTickFunction)
+{
+	GravityUpdateTick.AddPrerequisite(TargetObject, TargetTickFunction);
+}
+
+/**
+ * @brief Makes another tick function wait for the central gravity update pass.
+ *
+ * @details Used by components reading the gravity vector of their owner (movement, orientation),
+ * so they always read the gravity computed for the current frame, whether their owner ticks or not.
+ *
+ * @param DependentTickFunction The tick function to run after the gravity update pass.
+ */
+void UGravityWorldSubsystem::AddGravityUpdateDependent(FTickFunction& DependentTickFunction)
+{
+	DependentTickFunction.AddPrerequisite(this, GravityUpdateTick);
+}
+
+/**
+ * @brief Stops another tick function from waiting for the central gravity update pass.
+ *
+ * @param DependentTickFunction The tick function added with AddGravityUpdateDependent.
+ */
+void UGravityWorldSubsystem::RemoveGravityUpdateDependent(FTickFunction& DependentTickFunction)
+{
+	DependentTickFunction.RemovePrerequisite(this, GravityUpdateTick);
+}
+
+/**
+ * @brief Registers a gravity-affected actor with the central gravity update pass.
+ *
+ * @details From now on, the actor's gravity vector is updated once per frame by
+ * UpdateGravityAffectedActors, and its primary tick waits for that pass. Actors that do not
+ * implement IGravityAffected, or are already registered, are ignored.
+ *
+ * @param AffectedActor The actor to register.
+ */
+void UGravityWorldSubsystem::RegisterGravityAffected(AActor* AffectedActor)
+{
+	IGravityAffected* GravityAffected = Cast<IGravityAffected>(AffectedActor);
+	if (!GravityAffected || AffectedEntries.ContainsByPredicate([AffectedActor](const FGravityAffectedEntry& Entry) { return Entry.Actor == AffectedActor; }))
+	{
+		return;
+	}
+
+	AffectedEntries.Add({ AffectedActor, GravityAffected });
+	AffectedActor->PrimaryActorTick.AddPrerequisite(this, GravityUpdateTick);
+}
+
+/**
+ * @brief Unregisters a gravity-affected actor from the central gravity update pass.
+ *
+ * @param AffectedActor The actor to unregister.
+ */
+void UGravityWorldSubsystem::UnregisterGravityAffected(AActor* AffectedActor)
+{
+	if (!AffectedActor)
+	{
+		return;
+	}
+
+	const int32 RemovedCount = AffectedEntries.RemoveAllSwap([AffectedActor](const FGravityAffectedEntry& Entry) { return Entry.Actor == AffectedActor; }, EAllowShrinking::No);
+	if (RemovedCount > 0)
+	{
+		AffectedActor->PrimaryActorTick.RemovePrerequisite(this, GravityUpdateTick);
+	}
+}
+
+/**
+ * @brief Gets the handle of a registered gravity field.
+ *
+ * @param GravityField The gravity field to look up.
+ * @return The field's handle, or an unset handle if the field is not registered here.
+ */
+FGravityFieldHandle UGravityWorldSubsystem::GetGravityFieldHandle(const UBaseGravityFieldComponent* GravityField) const
+{
+	if (GravityField && ResolveGravityField(GravityField->GetGravityFieldHandle()) == GravityField)
+	{
+		return GravityField->GetGravityFieldHandle();
+	}
+	return FGravityFieldHandle();
+}
+
+/**
+ * @brief Collects every registered gravity field whose volume contains a location.
+ *
+ * @details Replaces the "scan all actors and look for a gravity component" pattern.
+ * The AABB tree returns the candidate fields, then each candidate is tested exactly
+ * against its volume's own shape.
+ *
+ * @param Location The world location to test.
+ * @param OutGravityFields Receives the gravity fields containing the location, in no particular order.
+ */
+void UGravityWorldSubsystem::GetGravityFieldsAtLocation(const FVector& Location, TArray<UBaseGravityFieldComponent*>& OutGravityFields) const
+{
+	OutGravityFields.Reset();
+
+	FieldTree.QueryPoint(Location, [this, &Location, &OutGravityFields](FGravityFieldHandle Handle)
+	{
+		UBaseGravityFieldComponent* GravityField = FieldSlots[Handle.Index].GravityField;
+		if (GravityField->IsLocationInGravityField(Location))
+		{
+			OutGravityFields.Add(GravityField);
+		}
+	});
+}
+
+/**
+ * @brief Gets the highest priority gravity field containing a location.
+ *
+ * @details Follows the same selection rule as IGravityAffected::GetActiveGravityField and
+ * FGravityFieldScene: the highest priority wins and, on a tie, the latest registered field wins.
+ * Priorities are compared on the registry slots, only the exact volume test touches a field.
+ *
+ * @param Location The world location to test.
+ * @return The active gravity field at this location, or nullptr if none contains it.
+ */
+UBaseGravityFieldComponent* UGravityWorldSubsystem::GetActiveGravityFieldAtLocation(const FVector& Location) const
+{
+	const FGravityFieldSlot* ActiveSlot = nullptr;
+
+	FieldTree.QueryPoint(Location, [this, &Location, &ActiveSlot](FGravityFieldHandle Handle)
+	{
+		const FGravityFieldSlot& Slot = FieldSlots[Handle.Index];
+		if (IsHigherPriorityField(Slot, ActiveSlot) && Slot.GravityField->IsLocationInGravityField(Location))
+		{
+			ActiveSlot = &Slot;
+		}
+	});
+
+	return ActiveSlot ? ActiveSlot->GravityField : nullptr;
+}
+
+/**
+ * @brief Gets the active gravity field for each location of a batch.
+ *
+ * @param Locations The world locations to test.
+ * @param OutActiveFields Receives the active gravity field of each location, or nullptr.
+ */
+void UGravityWorldSubsystem::GetActiveGravityFieldsAtLocations(TConstArrayView<FVector> Locations, TArrayView<UBaseGravityFieldComponent*> OutActiveFields) const
+{
+	check(OutActiveFields.Num() >= Locations.Num());
+
+	TArray<const FGravityFieldSlot*> ActiveSlots;
+	ActiveSlots.SetNumZeroed(Locations.Num());
+
+	FieldTree.QueryPoints(Locations, [this, &Locations, &ActiveSlots](int32 Index, FGravityFieldHandle Handle)
+	{
+		const FGravityFieldSlot& Slot = FieldSlots[Handle.Index];
+		if (IsHigherPriorityField(Slot, ActiveSlots[Index]) && Slot.GravityField->IsLocationInGravityField(Locations[Index]))
+		{
+			ActiveSlots[Index] = &Slot;
+		}
+	});
+
+	for (int32 Index = 0; Index < Locations.Num(); ++Index)
+	{
+		OutActiveFields[Index] = ActiveSlots[Index] ? ActiveSlots[Index]->GravityField : nullptr;
+	}
+}
+
+/**
+ * @brief Mirrors the snapshots of every registered field into a new thread-safe scene.
+ *
+ * @details Must be called on the game thread. The spatial index is copied along with the
+ * snapshots, so readers can run location queries without the game thread's tree. The previous
+ * scene is not modified: readers that still hold it keep a consistent view until they release
+ * it. Called automatically at the start of each world tick in which a field changed, and can be
+ * called manually after changing fields mid-frame.
+ */
+void UGravityWorldSubsystem::PublishGravityScene()
+{
+	check(IsInGameThread());
+
+	TSharedRef<FGravityFieldScene, ESPMode::ThreadSafe> NewScene = MakeShared<FGravityFieldScene, ESPMode::ThreadSafe>();
+	NewScene->Fields.Reserve(GravityFields.Num());
+	NewScene->FieldHandles.Reserve(GravityFields.Num());
+	NewScene->FieldTree = FieldTree;
+	NewScene->FieldIndexBySlot.Init(INDEX_NONE, FieldSlots.Num());
+
+	for (const UBaseGravityFieldComponent* GravityField : GravityFields)
+	{
+		if (GravityField)
+		{
+			NewScene->FieldIndexBySlot[GravityField->GetGravityFieldHandle().Index] = NewScene->Fields.Num();
+			NewScene->Fields.Add(GravityField->GetFieldSnapshot());
+			NewScene->FieldHandles.Add(GravityField->GetGravityFieldHandle());
+		}
+	}
+
+	bGravitySceneDirty = false;
+
+	FWriteScopeLock WriteLock(GravitySceneLock);
+	GravityScene = NewScene;
+}
+
+/**
+ * @brief Gets the last published gravity scene.
+ *
+ * @details Safe to call from any thread. The returned scene stays valid and unchanged for
+ * as long as the caller holds the pointer, even if a newer scene is published meanwhile.
+ *
+ * @return The last published gravity scene.
+ */
+TSharedPtr<const FGravityFieldScene, ESPMode::ThreadSafe> UGravityWorldSubsystem::GetGravityScene() const
+{
+	FReadScopeLock ReadLock(GravitySceneLock);
+	return GravityScene;
+}
+
+/**
+ * @brief Updates the gravity vector of every registered gravity-affected actor.
+ *
+ * @details Runs once per frame from the gravity update tick function, in three steps:
+ * 1. Gather (game thread): picks the actors due for an update this frame (see below), then
+ *    reads their location, whether they blend fields, and copies the snapshot of their active
+ *    field into the request
+ * 2. Evaluate (worker threads): runs the shape kernels on the copied snapshots, or the
+ *    compositor on the published scene for blending actors; this step touches no UObject
+ * 3. Write back (game thread): stores each result through IGravityAffected::GetGravityVector,
+ *    and extrapolates the gravity of the actors that were skipped
+ *
+ * After each evaluation, an actor is given an update interval from its distance to the closest
+ * player view and whether it was rendered recently (see CalculateUpdateInterval). Between two
+ * evaluations, its gravity direction keeps turning at the per-frame rate measured between its
+ * last two evaluations, while its magnitude stays the one last evaluated, so the extrapolated
+ * vector can neither drift in strength nor pass through zero. An actor whose active field
+ * changed is always evaluated right away.
+ *
+ * Due actors then go through a temporal cache: the last evaluated sample is reused while the
+ * actor stayed within mgg.Gravity.TemporalCacheTolerance of where it was taken, and its active
+ * field is still the same field at the same version (see IsTemporalCacheHit). Blending actors
+ * depend on every overlapping field, so they always evaluate.
+ *
+ * Actors without any field keep their current gravity vector, as UpdateCurrentGravityField does.
+ */
+void UGravityWorldSubsystem::UpdateGravityAffectedActors()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GravityUpdatePass);
+	check(IsInGameThread());
+
+	AffectedEntries.RemoveAllSwap([](const FGravityAffectedEntry& Entry) { return !Entry.Actor.IsValid(); }, EAllowShrinking::No);
+
+	const int32 NumActors = AffectedEntries.Num();
+	if (NumActors == 0)
+	{
+		return;
+	}
+
+	GatherViewLocations();
+	UpdateRequests.Reset();
+
+	int32 NumCacheHits = 0;
+	int32 NumCacheMisses = 0;
+
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		FGravityAffectedEntry& Entry = AffectedEntries[Index];
+		const bool bActiveFieldChanged = Entry.GravityAffected->ConsumeActiveGravityFieldChanged();
+
+		if (!bActiveFieldChanged && Entry.bHasGravityVector && Entry.FramesUntilUpdate > 0)
+		{
+			--Entry.FramesUntilUpdate;
+			continue;
+		}
+
+		const UBaseGravityFieldComponent* ActiveField = Entry.GravityAffected->GetActiveGravityField();
+
+		FGravityUpdateRequest& Request = UpdateRequests.AddDefaulted_GetRef();
+		Request.EntryIndex = Index;
+		Request.Location = Entry.Actor->GetActorLocation();
+		Request.bBlendGravityFields = Entry.GravityAffected->ShouldBlendGravityFields();
+		Request.bActiveFieldChanged = bActiveFieldChanged;
+
+		if (Request.bBlendGravityFields || !ActiveField)
+		{
+			Entry.CachedField.Reset();
+		}
+		else if (IsTemporalCacheHit(Entry, *ActiveField, Request.Location))
+		{
+			Request.GravityVector = Entry.LastGravityVector;
+			Request.bHasGravityVector = true;
+			++NumCacheHits;
+		}
+		else
+		{
+			Entry.CachedLocation = Request.Location;
+			Entry.CachedField = ActiveField->GetGravityFieldHandle();
+			Entry.CachedFieldVersion = ActiveField->GetFieldVersion();
+			Request.ActiveSnapshot = ActiveField->GetFieldSnapshot();
+			Request.bHasActiveSnapshot = true;
+			++NumCacheMisses;
+		}
+	}
+
+	const int32 NumRequests = UpdateRequests.Num();
+	INC_DWORD_STAT_BY(STAT_GravityUpdatedActors, NumRequests);
+	INC_DWORD_STAT_BY(STAT_GravitySkippedUpdates, NumActors - NumRequests);
+	INC_DWORD_STAT_BY(STAT_GravityTemporalCacheHits, NumCacheHits);
+	INC_DWORD_STAT_BY(STAT_GravityTemporalCacheMisses, NumCacheMisses);
+	SET_FLOAT_STAT(STAT_GravityTemporalCacheHitRate, NumCacheHits + NumCacheMisses > 0 ? 100.0f * NumCacheHits / (NumCacheHits + NumCacheMisses) : 0.0f);
+
+	const TSharedPtr<const FGravityFieldScene, ESPMode::ThreadSafe> Scene = GetGravityScene();
+
+	ParallelFor(NumRequests, [this, &Scene](int32 Index)
+	{
+		FGravityUpdateRequest& Request = UpdateRequests[Index];
+
+		if (Request.bHasGravityVector)
+		{
+			return;
+		}
+
+		if (Request.bBlendGravityFields && Scene && Scene->CompositeGravityVector(Request.Location, Request.GravityVector))
+		{
+			Request.bHasGravityVector = true;
+		}
+		else if (Request.bHasActiveSnapshot)
+		{
+			Request.GravityVector = FGravityFieldMath::CalculateGravityVector(Request.ActiveSnapshot, Request.Location);
+			Request.bHasGravityVector = true;
+		}
+	}, GGravityParallelUpdate ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	// Every actor ages by one frame, the evaluated ones are reset below
+	for (FGravityAffectedEntry& Entry : AffectedEntries)
+	{
+		++Entry.FramesSinceUpdate;
+	}
+
+	for (const FGravityUpdateRequest& Request : UpdateRequests)
+	{
+		FGravityAffectedEntry& Entry = AffectedEntries[Request.EntryIndex];
+
+		if (!Request.bHasGravityVector)
+		{
+			Entry.bHasGravityVector = false;
+			Entry.FramesSinceUpdate = 0;
+			continue;
+		}
+
+		// No extrapolation across a change of field, the two vectors are unrelated
+		Entry.GravityTurnAxis = FVector::UpVector;
+		Entry.GravityTurnRate = 0.0f;
+		if (Entry.bHasGravityVector && !Request.bActiveFieldChanged)
+		{
+			float TurnAngle = 0.0f;
+			FQuat::FindBetweenVectors(Entry.LastGravityVector, Request.GravityVector).ToAxisAndAngle(Entry.GravityTurnAxis, TurnAngle);
+			Entry.GravityTurnRate = TurnAngle / Entry.FramesSinceUpdate;
+		}
+		// The first evaluation is staggered by entry index, so actors sharing an interval spread over its frames
+		const int32 UpdateInterval = CalculateUpdateInterval(*Entry.Actor);
+		Entry.FramesUntilUpdate = Entry.bHasGravityVector ? UpdateInterval - 1 : Request.EntryIndex % UpdateInterval;
+
+		Entry.LastGravityVector = Request.GravityVector;
+		Entry.FramesSinceUpdate = 0;
+		Entry.bHasGravityVector = true;
+
+		Entry.GravityAffected->GetGravityVector() = Request.GravityVector;
+	}
+
+	if (NumRequests == NumActors)
+	{
+		return;
+	}
+
+	for (FGravityAffectedEntry& Entry : AffectedEntries)
+	{
+		if (Entry.bHasGravityVector && Entry.FramesSinceUpdate > 0)
+		{
+			Entry.GravityAffected->GetGravityVector() = FQuat(Entry.GravityTurnAxis, Entry.GravityTurnRate * Entry.FramesSinceUpdate).RotateVector(Entry.LastGravityVector);
+		}
+	}
+}
+
+/**
+ * @brief Checks whether an actor's last gravity sample can be reused.
+ *
+ * @details The sample is keyed on the field it was taken from, that field's version and the
+ * location it was taken at. The field version changes whenever the field moves or its settings
+ * change, so only the actor's own displacement has to be measured.
+ *
+ * @param Entry The registered actor, holding its last sample.
+ * @param ActiveField The actor's current active field.
+ * @param Location The actor's current location.
+ * @return True if the last sample is still valid for this location.
+ */
+bool UGravityWorldSubsystem::IsTemporalCacheHit(const FGravityAffectedEntry& Entry, const UBaseGravityFieldComponent& ActiveField, const FVector& Location)
+{
+	return GGravityTemporalCacheTolerance > 0.0f
+		&& Entry.bHasGravityVector
+		&& Entry.CachedField == ActiveField.GetGravityFieldHandle()
+		&& Entry.CachedFieldVersion == ActiveField.GetFieldVersion()
+		&& FVector::DistSquared(Entry.CachedLocation, Location) <= FMath::Square(GGravityTemporalCacheTolerance);
+}
+
+/**
+ * @brief Collects the view location of every local player of the world.
+ *
+ * @details Dedicated servers have no local view: every controlled pawn is used instead, so
+ * the actors near any player keep their full update rate.
+ */
+void UGravityWorldSubsystem::GatherViewLocations()
+{
+	ViewLocations.Reset();
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (const APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
+
+/**
+ * @brief Calculates how many frames an actor's gravity may go without being evaluated.
+ *
+ * @details The interval grows linearly from 1 (every frame) at mgg.Gravity.UpdateRateNearDistance
+ * of the closest player view, to mgg.Gravity.UpdateRateMaxInterval at mgg.Gravity.UpdateRateFarDistance.
+ * Actors that were not rendered recently are scored as if they were twice as far.
+ *
+ * @param AffectedActor The actor to score.
+ * @return The number of frames between two evaluations of the actor's gravity, at least 1.
+ */
+int32 UGravityWorldSubsystem::CalculateUpdateInterval(const AActor& AffectedActor) const
+{
+	if (GGravityUpdateRateMaxInterval <= 1 || ViewLocations.Num() == 0)
+	{
+		return 1;
+	}
+
+	const FVector ActorLocation = AffectedActor.GetActorLocation();
+	float ClosestDistanceSquared = TNumericLimits<float>::Max();
+
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, static_cast<float>(FVector::DistSquared(ActorLocation, ViewLocation)));
+	}
+
+	float Distance = FMath::Sqrt(ClosestDistanceSquared);
+	if (!AffectedActor.WasRecentlyRendered())
+	{
+		Distance *= 2.0f;
+	}
+
+	const float Significance = FMath::GetRangePct(GGravityUpdateRateNearDistance, FMath::Max(GGravityUpdateRateFarDistance, GGravityUpdateRateNearDistance + 1.0f), Distance);
+	return 1 + FMath::FloorToInt32(FMath::Clamp(Significance, 0.0f, 1.0f) * (GGravityUpdateRateMaxInterval - 1));
+}
+
+/**
+ * @brief Flushes the dirty list, then publishes the gravity scene if a field changed, at the start of this subsystem's world tick.
+ *
+ * @param TickingWorld The world starting its tick.
+ * @param TickType The kind of tick being performed.
+ * @param DeltaSeconds The frame delta time.
+ */
+void UGravityWorldSubsystem::OnWorldTickStart(UWorld* TickingWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (TickingWorld == GetWorld())
+	{
+		SynchronizeGravityFields();
+	}
+}
+
+/**
+ * @brief Checks whether a candidate field should replace the current active field.
+ *
+ * @param Candidate The registry slot of the field being considered.
+ * @param Current The registry slot of the currently selected field, may be nullptr.
+ * @return True if the candidate has a higher priority, or the same priority and a later registration.
+ */
+bool UGravityWorldSubsystem::IsHigherPriorityField(const FGravityFieldSlot& Candidate, const FGravityFieldSlot* Current)
+{
+	if (!Current)
+	{
+		return true;
+	}
+
+	if (Candidate.Priority != Current->Priority)
+	{
+		return Candidate.Priority > Current->Priority;
+	}
+
+	return Candidate.RegistrationOrder > Current->RegistrationOrder;
+}
+
+/**
+ * @brief Gets the gravity subsystem of the world an object lives in.
+ *
+ * @param WorldContextObject Any object living in the target world.
+ * @return The gravity subsystem, or nullptr if the object has no world.
+ */
+UGravityWorldSubsystem* UGravityWorldSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr)
+	{
+		return World->GetSubsystem<UGravityWorldSubsystem>();
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Runs the central gravity update pass of the target subsystem.
+ *
+ * @details Synchronizes the fields first, so changes made since the start of the frame (gameplay
+ * code, Blueprints, Sequencer) are not a frame late.
+ *
+ * @param DeltaTime The frame delta time.
+ * @param TickType The kind of tick being performed.
+ * @param CurrentThread The thread this tick runs on.
+ * @param MyCompletionGraphEvent The completion event of this tick.
+ */
+void FGravityUpdateTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->SynchronizeGravityFields();
+		Target->UpdateGravityAffectedActors();
+	}
+}
+
+/**
+ * @brief Describes this tick function in tick diagnostics.
+ *
+ * @return The diagnostic description.
+ */
+FString FGravityUpdateTickFunction::DiagnosticMessage()
+{
+	return TEXT("FGravityUpdateTickFunction");
+}
+
+/**
+ * @brief Names this tick function in tick diagnostics and CSV stats.
+ *
+ * @param bDetailed Whether a detailed context is requested.
+ * @return The diagnostic context name.
+ */
+FName FGravityUpdateTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("GravityUpdateTick"));
+}
@@ -0,0 +1,211 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "MGG/Utils/Spatial/GravityFieldAABBTree.h"
+#include "MGG/GravityFields/GravityFieldScene.h"
+#include "GravityWorldSubsystem.generated.h"
+
+//////// FORWARD DECLARATION ////////
+//// Class
+class AActor;
+class UBaseGravityFieldComponent;
+class UGravityWorldSubsystem;
+class IGravityAffected;
+
+/**
+ * @brief Tick function running the central gravity update pass of a world.
+ *
+ * @details Registered by the gravity subsystem in TG_PrePhysics. Every registered
+ * gravity-affected actor's primary tick depends on it, so actors always move with
+ * the gravity computed for the current frame. The dirty fields are flushed first, so
+ * the pass sees every field change made earlier in the frame.
+ */
+USTRUCT()
+struct FGravityUpdateTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	//////// FIELDS ////////
+	UGravityWorldSubsystem* Target = nullptr;
+
+	//////// METHODS ////////
+	//// FTickFunction implementation
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGravityUpdateTickFunction> : public TStructOpsTypeTraitsBase2<FGravityUpdateTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * @brief World-level registry of every gravity field component.
+ *
+ * @details Gravity fields register themselves when they are registered with the scene
+ * and unregister when they are destroyed. This gives gameplay code a single place to ask
+ * "which fields contain this point" without scanning every actor of the level.
+ *
+ * Each registered field owns a slot of a dense registry and is referenced everywhere else
+ * (spatial index, gravity-affected actors) by a generational FGravityFieldHandle, which stops
+ * resolving as soon as the field is unregistered.
+ *
+ * Field volumes are indexed in a dynamic AABB tree, so location queries (spawn-time membership,
+ * Mass entities, the gravity scene) are logarithmic in the number of fields and do not depend on
+ * physics overlap generation. The fields a gravity-affected actor is in are still tracked through
+ * the overlap events of the field volumes.
+ *
+ * Fields do not rebuild themselves when they change: they queue what changed in the subsystem's
+ * dirty list, which is flushed at the start of every world tick and again right before the gravity
+ * update pass, so fields moved earlier in the frame (by gameplay code, Blueprints or Sequencer)
+ * are seen by that pass. A field changed after it is picked up next frame, unless its owner calls
+ * SynchronizeGravityFields. After each flush, the subsystem publishes a new immutable
+ * FGravityFieldScene built from the field snapshots, only if a field changed. That scene is the
+ * only gravity data worker threads are allowed to read; everything else here is game thread only.
+ *
+ * Gravity-affected actors register here too. Once per frame, before their own ticks, the
+ * subsystem updates the gravity vector of all of them in a single pass whose evaluation
+ * runs across worker threads (see UpdateGravityAffectedActors). Actors far from every player
+ * view, or not rendered, are only evaluated every few frames and extrapolated in between.
+ */
+UCLASS()
+class MGG_API UGravityWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//////// UNREAL LIFECYCLE ////////
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	//////// METHODS ////////
+	//// Static methods
+	static UGravityWorldSubsystem* Get(const UObject* WorldContextObject);
+
+	//// Registration methods
+	void RegisterGravityField(UBaseGravityFieldComponent* GravityField);
+	void UnregisterGravityField(UBaseGravityFieldComponent* GravityField);
+	void UpdateGravityField(UBaseGravityFieldComponent* GravityField);
+	void EnqueueDirtyGravityField(UBaseGravityFieldComponent* GravityField);
+	void FlushDirtyGravityFields();
+	void SynchronizeGravityFields();
+	void RegisterGravityAffected(AActor* AffectedActor);
+	void UnregisterGravityAffected(AActor* AffectedActor);
+
+	//// Handle methods
+	FGravityFieldHandle GetGravityFieldHandle(const UBaseGravityFieldComponent* GravityField) const;
+
+	//// Query methods
+	void GetGravityFieldsAtLocation(const FVector& Location, TArray<UBaseGravityFieldComponent*>& OutGravityFields) const;
+	UBaseGravityFieldComponent* GetActiveGravityFieldAtLocation(const FVector& Location) const;
+	void GetActiveGravityFieldsAtLocations(TConstArrayView<FVector> Locations, TArrayView<UBaseGravityFieldComponent*> OutActiveFields) const;
+
+	//// Thread-safe scene methods
+	void PublishGravityScene();
+	TSharedPtr<const FGravityFieldScene, ESPMode::ThreadSafe> GetGravityScene() const;
+
+	//// Update methods
+	void UpdateGravityAffectedActors();
+	void AddGravityUpdatePrerequisite(UObject* TargetObject, FTickFunction& TargetTickFunction);
+	void AddGravityUpdateDependent(FTickFunction& DependentTickFunction);
+	void RemoveGravityUpdateDependent(FTickFunction& DependentTickFunction);
+
+	//////// INLINE METHODS ////////
+	//// Getters accessors
+	FORCEINLINE const TArray<UBaseGravityFieldComponent*>& GetGravityFields() const { return GravityFields; }
+	FORCEINLINE UBaseGravityFieldComponent* ResolveGravityField(FGravityFieldHandle Handle) const { return IsValidHandle(Handle) ? FieldSlots[Handle.Index].GravityField : nullptr; }
+	FORCEINLINE uint32 GetRegistrationOrder(FGravityFieldHandle Handle) const { return IsValidHandle(Handle) ? FieldSlots[Handle.Index].RegistrationOrder : 0; }
+
+	//// Check methods
+	FORCEINLINE bool IsValidHandle(FGravityFieldHandle Handle) const { return FieldSlots.IsValidIndex(Handle.Index) && FieldSlots[Handle.Index].Generation == Handle.Generation; }
+
+private:
+	//////// STRUCTS ////////
+	struct FGravityFieldSlot
+	{
+		UBaseGravityFieldComponent* GravityField = nullptr;
+		uint32 Generation = 1;
+		int32 ProxyId = INDEX_NONE;
+		int32 Priority = 0;
+		uint32 RegistrationOrder = 0;
+		int32 NextFreeSlot = INDEX_NONE;
+	};
+
+	struct FGravityAffectedEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		IGravityAffected* GravityAffected = nullptr;
+
+		// Update rate state
+		FVector LastGravityVector = FVector::ZeroVector;
+		FVector GravityTurnAxis = FVector::UpVector; // Turn of the gravity direction per frame, used to extrapolate skipped frames
+		float GravityTurnRate = 0.0f; // Radians per frame around GravityTurnAxis
+		int32 FramesSinceUpdate = 0;
+		int32 FramesUntilUpdate = 0;
+		bool bHasGravityVector = false;
+
+		// Temporal cache, the last evaluated sample is reused while its key still matches
+		FVector CachedLocation = FVector::ZeroVector;
+		FGravityFieldHandle CachedField;
+		uint32 CachedFieldVersion = 0;
+	};
+
+	struct FGravityUpdateRequest
+	{
+		int32 EntryIndex = INDEX_NONE;
+		FVector Location = FVector::ZeroVector;
+		FGravityFieldSnapshot ActiveSnapshot; // Copied on the game thread, so workers never read a field component
+		bool bHasActiveSnapshot = false;
+		bool bBlendGravityFields = false;
+		bool bActiveFieldChanged = false;
+		bool bHasGravityVector = false;
+		FVector GravityVector = FVector::ZeroVector;
+	};
+
+	//////// FIELDS ////////
+	//// Gravity fields
+	UPROPERTY(Transient)
+	TArray<UBaseGravityFieldComponent*> GravityFields;
+
+	//// Registry fields
+	TArray<FGravityFieldSlot> FieldSlots;
+	int32 FirstFreeSlot = INDEX_NONE;
+	uint32 NextRegistrationOrder = 0;
+
+	//// Spatial index fields
+	FGravityFieldAABBTree FieldTree;
+
+	//// Dirty list fields
+	TArray<UBaseGravityFieldComponent*> DirtyFields;
+	TArray<UBaseGravityFieldComponent*> FlushingFields;
+	bool bGravitySceneDirty = true;
+
+	//// Thread-safe scene fields
+	TSharedPtr<const FGravityFieldScene, ESPMode::ThreadSafe> GravityScene;
+	mutable FRWLock GravitySceneLock;
+	FDelegateHandle WorldTickStartHandle;
+
+	//// Gravity-affected fields
+	TArray<FGravityAffectedEntry> AffectedEntries;
+	TArray<FGravityUpdateRequest> UpdateRequests;
+	TArray<FVector> ViewLocations;
+	FGravityUpdateTickFunction GravityUpdateTick;
+
+	//////// METHODS ////////
+	//// Helper methods
+	static bool IsHigherPriorityField(const FGravityFieldSlot& Candidate, const FGravityFieldSlot* Current);
+	static bool IsTemporalCacheHit(const FGravityAffectedEntry& Entry, const UBaseGravityFieldComponent& ActiveField, const FVector& Location);
+	void GatherViewLocations();
+	int32 CalculateUpdateInterval(const AActor& AffectedActor) const;
+
+	//// Event methods
+	void OnWorldTickStart(UWorld* TickingWorld, ELevelTick TickType, float DeltaSeconds);
+};
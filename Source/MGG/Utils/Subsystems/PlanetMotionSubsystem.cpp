@@ -0,0 +1,244 @@
+﻿#include "PlanetMotionSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "MGG/Planets/BasePlanet.h"
+#include "MGG/GravityFields/GravityStats.h"
+#include "MGG/Utils/Subsystems/GravityWorldSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Planet Motion Pass"), STAT_PlanetMotionPass, STATGROUP_MGGGravity);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Moving Planets"), STAT_MovingPlanets, STATGROUP_MGGGravity);
+
+/**
+ * @brief Called when the subsystem is created for its world.
+ *
+ * @details The gravity subsystem is initialized first, since every motion pass ends by
+ * flushing its dirty fields.
+ *
+ * @param Collection The subsystem collection this subsystem belongs to.
+ */
+void UPlanetMotionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency<UGravityWorldSubsystem>();
+	Super::Initialize(Collection);
+
+	MotionTick.Target = this;
+	MotionTick.TickGroup = TG_PrePhysics;
+	MotionTick.bCanEverTick = true;
+	MotionTick.bStartWithTickEnabled = true;
+}
+
+/**
+ * @brief Called when the world owning this subsystem is torn down.
+ */
+void UPlanetMotionSubsystem::Deinitialize()
+{
+	if (MotionTick.IsTickFunctionRegistered())
+	{
+		MotionTick.UnRegisterTickFunction();
+	}
+
+	Planets.Reset();
+	MotionSettings.Reset();
+	MotionStates.Reset();
+	PlanetTransforms.Reset();
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Called when the world owning this subsystem begins play.
+ *
+ * @details Registers the motion tick function and makes the gravity update pass wait for it.
+ *
+ * @param InWorld The world beginning play.
+ */
+void UPlanetMotionSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	MotionTick.RegisterTickFunction(InWorld.PersistentLevel);
+
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(&InWorld))
+	{
+		GravitySubsystem->AddGravityUpdatePrerequisite(this, MotionTick);
+	}
+}
+
+/**
+ * @brief Registers a moving planet with the motion pass.
+ *
+ * @details The orbit starts from the planet's current location: its direction from the orbit
+ * center becomes the angle 0 of the orbit and its height along the orbit axis is kept.
+ * Registering a planet again replaces its settings and restarts its motion from where it stands.
+ *
+ * @param Planet The planet to move.
+ * @param Settings The planet's motion settings.
+ */
+void UPlanetMotionSubsystem::RegisterPlanet(ABasePlanet* Planet, const FPlanetMotionSettings& Settings)
+{
+	if (!Planet)
+	{
+		return;
+	}
+
+	UnregisterPlanet(Planet);
+
+	const FVector OrbitAxis = Settings.OrbitAxis.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+	const FVector FromCenter = Planet->GetActorLocation() - Settings.OrbitCenter;
+	const FVector PlanarOffset = FVector::VectorPlaneProject(FromCenter, OrbitAxis);
+
+	FPlanetMotionState State;
+	State.OrbitOffset = FromCenter - PlanarOffset;
+	State.OrbitRadial = PlanarOffset.GetSafeNormal();
+	if (State.OrbitRadial.IsZero())
+	{
+		FVector UnusedAxis;
+		OrbitAxis.FindBestAxisVectors(State.OrbitRadial, UnusedAxis);
+	}
+	State.OrbitRadius = Settings.OrbitRadius > 0.0f ? Settings.OrbitRadius : static_cast<float>(PlanarOffset.Size());
+	State.BaseRotation = Planet->GetActorQuat();
+
+	FPlanetMotionSettings& StoredSettings = MotionSettings.Add_GetRef(Settings);
+	StoredSettings.OrbitAxis = OrbitAxis;
+	StoredSettings.SpinAxis = Settings.SpinAxis.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+
+	Planets.Add(Planet);
+	MotionStates.Add(State);
+}
+
+/**
+ * @brief Stops moving a planet.
+ *
+ * @param Planet The planet to stop.
+ */
+void UPlanetMotionSubsystem::UnregisterPlanet(ABasePlanet* Planet)
+{
+	const int32 Index = Planets.IndexOfByKey(Planet);
+	if (Index != INDEX_NONE)
+	{
+		RemovePlanetAt(Index);
+	}
+}
+
+/**
+ * @brief Advances every registered planet by one frame.
+ *
+ * @details Runs in two passes:
+ * 1. Advances all orbit and spin angles and computes every new transform, reading only the
+ *    compact motion arrays
+ * 2. Applies the transforms; each moved field queues a kinematic update in the gravity
+ *    subsystem's dirty list, which is then flushed once for all of them
+ *
+ * @param DeltaTime The frame delta time.
+ */
+void UPlanetMotionSubsystem::AdvancePlanets(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PlanetMotionPass);
+
+	for (int32 Index = Planets.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Planets[Index].IsValid())
+		{
+			RemovePlanetAt(Index);
+		}
+	}
+
+	const int32 NumPlanets = Planets.Num();
+	if (NumPlanets == 0)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_MovingPlanets, NumPlanets);
+
+	PlanetTransforms.SetNum(NumPlanets, EAllowShrinking::No);
+
+	for (int32 Index = 0; Index < NumPlanets; ++Index)
+	{
+		const FPlanetMotionSettings& Settings = MotionSettings[Index];
+		FPlanetMotionState& State = MotionStates[Index];
+
+		State.OrbitAngle = FMath::Fmod(State.OrbitAngle + FMath::DegreesToRadians(Settings.OrbitAngularSpeed) * DeltaTime, UE_TWO_PI);
+		State.SpinAngle = FMath::Fmod(State.SpinAngle + FMath::DegreesToRadians(Settings.SpinAngularSpeed) * DeltaTime, UE_TWO_PI);
+
+		const FVector OrbitRadial = FQuat(Settings.OrbitAxis, State.OrbitAngle).RotateVector(State.OrbitRadial);
+		const FVector Location = Settings.OrbitCenter + State.OrbitOffset + OrbitRadial * State.OrbitRadius;
+		const FQuat Rotation = State.BaseRotation * FQuat(Settings.SpinAxis, State.SpinAngle);
+
+		PlanetTransforms[Index].SetLocation(Location);
+		PlanetTransforms[Index].SetRotation(Rotation);
+	}
+
+	for (int32 Index = 0; Index < NumPlanets; ++Index)
+	{
+		Planets[Index]->SetActorLocationAndRotation(PlanetTransforms[Index].GetLocation(), PlanetTransforms[Index].GetRotation());
+	}
+
+	if (UGravityWorldSubsystem* GravitySubsystem = UGravityWorldSubsystem::Get(this))
+	{
+		GravitySubsystem->SynchronizeGravityFields();
+	}
+}
+
+/**
+ * @brief Removes a planet from the motion arrays.
+ *
+ * @param Index The index of the planet in the motion arrays.
+ */
+void UPlanetMotionSubsystem::RemovePlanetAt(int32 Index)
+{
+	Planets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MotionSettings.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MotionStates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+/**
+ * @brief Gets the planet motion subsystem of the world an object lives in.
+ *
+ * @param WorldContextObject Any object living in the target world.
+ * @return The planet motion subsystem, or nullptr if the object has no world.
+ */
+UPlanetMotionSubsystem* UPlanetMotionSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr)
+	{
+		return World->GetSubsystem<UPlanetMotionSubsystem>();
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Runs the planet motion pass of the target subsystem.
+ *
+ * @param DeltaTime The frame delta time.
+ * @param TickType The kind of tick being performed.
+ * @param CurrentThread The thread this tick runs on.
+ * @param MyCompletionGraphEvent The completion event of this tick.
+ */
+void FPlanetMotionTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->AdvancePlanets(DeltaTime);
+	}
+}
+
+/**
+ * @brief Describes this tick function in tick diagnostics.
+ *
+ * @return The diagnostic description.
+ */
+FString FPlanetMotionTickFunction::DiagnosticMessage()
+{
+	return TEXT("FPlanetMotionTickFunction");
+}
+
+/**
+ * @brief Names this tick function in tick diagnostics and CSV stats.
+ *
+ * @param bDetailed Whether a detailed context is requested.
+ * @return The diagnostic context name.
+ */
+FName FPlanetMotionTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("PlanetMotionTick"));
+}
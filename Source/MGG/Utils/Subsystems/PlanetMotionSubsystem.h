@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "MGG/Planets/PlanetMotionSettings.h"
+#include "PlanetMotionSubsystem.generated.h"
+
+//////// FORWARD DECLARATION ////////
+//// Class
+class ABasePlanet;
+class UPlanetMotionSubsystem;
+
+/**
+ * @brief Tick function advancing every moving planet of a world.
+ *
+ * @details Registered by the planet motion subsystem in TG_PrePhysics. The gravity update pass
+ * depends on it, so gravity-affected actors are always evaluated against this frame's planets.
+ */
+USTRUCT()
+struct FPlanetMotionTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	//////// FIELDS ////////
+	UPlanetMotionSubsystem* Target = nullptr;
+
+	//////// METHODS ////////
+	//// FTickFunction implementation
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FPlanetMotionTickFunction> : public TStructOpsTypeTraitsBase2<FPlanetMotionTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * @brief Central orbit and spin system for moving planets.
+ *
+ * @details Planets with motion settings register here instead of ticking themselves. Once per
+ * frame, a single pass advances the orbit and spin angles of every registered planet from their
+ * compact settings, computes all the new transforms, applies them, and then flushes the gravity
+ * subsystem's dirty list so every moved field gets its snapshot refreshed in the same batch.
+ *
+ * Moving planets switch their gravity field to kinematic motion, so a frame of orbiting only
+ * refreshes the field transforms, never their dimensions.
+ */
+UCLASS()
+class MGG_API UPlanetMotionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//////// UNREAL LIFECYCLE ////////
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	//////// METHODS ////////
+	//// Static methods
+	static UPlanetMotionSubsystem* Get(const UObject* WorldContextObject);
+
+	//// Registration methods
+	void RegisterPlanet(ABasePlanet* Planet, const FPlanetMotionSettings& Settings);
+	void UnregisterPlanet(ABasePlanet* Planet);
+
+	//// Update methods
+	void AdvancePlanets(float DeltaTime);
+
+private:
+	//////// STRUCTS ////////
+	struct FPlanetMotionState
+	{
+		FVector OrbitRadial = FVector::ForwardVector;	// Unit direction from the orbit center at angle 0, perpendicular to the orbit axis
+		FVector OrbitOffset = FVector::ZeroVector;		// Offset along the orbit axis, kept from the placed location
+		float OrbitRadius = 0.0f;
+		float OrbitAngle = 0.0f;
+		FQuat BaseRotation = FQuat::Identity;
+		float SpinAngle = 0.0f;
+	};
+
+	//////// FIELDS ////////
+	//// Planet fields
+	TArray<TWeakObjectPtr<ABasePlanet>> Planets;
+	TArray<FPlanetMotionSettings> MotionSettings;
+	TArray<FPlanetMotionState> MotionStates;
+	TArray<FTransform> PlanetTransforms;
+
+	//// Tick fields
+	FPlanetMotionTickFunction MotionTick;
+
+	//////// METHODS ////////
+	//// Helper methods
+	void RemovePlanetAt(int32 Index);
+};